@@ -17,7 +17,12 @@ Akinator::Akinator () :
     path2badnode_ ((char*)"path to problem node"),
     state_        (AKN_OK)
 {
-    BASE_CHECK;
+    AKN_ASSERTOK(tree_.getErrCode(), AKN_INCORRECT_INPUT_SYNTAX_BASE);
+    BASE_CHECK();
+
+    loadStats();
+    tree_.Relayout();
+    buildIndex();
 }
 
 //------------------------------------------------------------------------------
@@ -28,7 +33,12 @@ Akinator::Akinator (char* filename) :
     filename_     (filename),
     state_        (AKN_OK)
 {
-    BASE_CHECK;
+    AKN_ASSERTOK(tree_.getErrCode(), AKN_INCORRECT_INPUT_SYNTAX_BASE);
+    BASE_CHECK();
+
+    loadStats();
+    tree_.Relayout();
+    buildIndex();
 }
 
 //------------------------------------------------------------------------------
@@ -40,6 +50,12 @@ Akinator::~Akinator ()
 
     filename_ = nullptr;
 
+    delete [] statname_;
+    statname_ = nullptr;
+
+    delete [] render_;
+    render_ = nullptr;
+
     state_ = AKN_DESTRUCTED;
 }
 
@@ -47,7 +63,8 @@ Akinator::~Akinator ()
 
 int Akinator::Run ()
 {
-    AKN_ASSERTOK((this == nullptr), AKN_NULL_INPUT_AKINATOR_PTR);
+    AKN_ASSERTOK((this == nullptr), AKN_NULL_INPUT_AKINATOR_PTR, AKN_NULL_INPUT_AKINATOR_PTR);
+    if (state_ != AKN_OK) return state_;
 
     tree_.Dump();
 
@@ -56,18 +73,24 @@ int Akinator::Run ()
     bool running = true;
     while (running)
     {
-        BASE_CHECK;
+        BASE_CHECK(state_);
     
         printf("\n%s:\n",     (lang_ == 0) ? "Choose a gamemode please" : "Пожалуйста, выберите режим игры");
         printf("\t[1]: %s\n", (lang_ == 0) ? "Guessing a character"     : "Угадать персонажа");
         printf("\t[2]: %s\n", (lang_ == 0) ? "Find a character"         : "Угадать персонажа");
         printf("\t[3]: %s\n", (lang_ == 0) ? "Character comparison"     : "Сравнение персонажей");
-        printf("\t[4]: %s\n", (lang_ == 0) ? "View the base"            : "Посмотреть базу данных");
-        printf("\t[5]: Change language | Сменить язык\n");
-        printf("\t[6]: %s\n", (lang_ == 0) ? "Exit"                     : "Выход");
+        printf("\t[4]: %s\n", (lang_ == 0) ? "Find characters by feature" : "Найти персонажей по признаку");
+        printf("\t[5]: %s\n", (lang_ == 0) ? "Import characters"        : "Импортировать персонажей");
+        printf("\t[6]: %s\n", (lang_ == 0) ? "Merge with another base"  : "Объединить с другой базой");
+        printf("\t[7]: %s\n", (lang_ == 0) ? "Export a subtree"         : "Выгрузить поддерево");
+        printf("\t[8]: %s\n", (lang_ == 0) ? "Pack the base"            : "Сжать базу данных");
+        printf("\t[9]: %s\n", (lang_ == 0) ? "View the base"            : "Посмотреть базу данных");
+        printf("\t[10]: %s\n", (lang_ == 0) ? "Performance report"      : "Отчёт о производительности");
+        printf("\t[11]: Change language | Сменить язык\n");
+        printf("\t[12]: %s\n", (lang_ == 0) ? "Exit"                    : "Выход");
         printf((lang_ == 0) ? "Enter a number: " : "Введите число: ");
 
-        int mode = scanNum(1, 6);
+        int mode = scanNum(1, 12);
 
         switch (mode)
         {
@@ -81,12 +104,31 @@ int Akinator::Run ()
             CharCmp();
             break;
         case 4:
-            printGraphBase();
+            FeatureFind();
             break;
         case 5:
-            lang_ = 1 - lang_;
+            Import();
             break;
         case 6:
+            Merge();
+            break;
+        case 7:
+            Export();
+            break;
+        case 8:
+            Pack();
+            break;
+        case 9:
+            printGraphBase();
+            break;
+        case 10:
+            Report();
+            break;
+        case 11:
+            lang_ = 1 - lang_;
+            break;
+        case 12:
+            tree_.WriteStats(statname_);
             running = false;
             break;
         default:
@@ -101,10 +143,17 @@ int Akinator::Run ()
 
 int Akinator::Guessing ()
 {
+    MET_TIMER(MET_GUESSING);
+
     Node<char*>* node_cur = tree_.root_;
 
     while (node_cur != nullptr)
     {
+        if (node_cur->isMount() && fetchShard(node_cur)) return AKN_OK;
+
+        tree_.Touch(node_cur);
+        node_cur->stats_.addVisit();
+
         bool isAns = false;
 
         char question[MAX_STR_LEN] = "";
@@ -117,15 +166,23 @@ int Akinator::Guessing ()
             question[strlen(question) - 1] = FEAT_SIGN;
             isAns = true;
         }
-        else AKN_ASSERTOK(AKN_INCORRECT_INPUT_SYNTAX_BASE, AKN_INCORRECT_INPUT_SYNTAX_BASE);
+        else AKN_ASSERTOK(AKN_INCORRECT_INPUT_SYNTAX_BASE, AKN_INCORRECT_INPUT_SYNTAX_BASE, AKN_INCORRECT_INPUT_SYNTAX_BASE);
 
         printf("\n%s - %s\n", (lang_ == 0) ? "Your character" : "Ваш персонаж", question);
         printf("%s [Y/n]? ",  (lang_ == 0) ? "Answer"         : "Ответ");
 
-        if (scanAns())
+        bool ans = scanAns();
+        node_cur->stats_.addAnswer(ans);
+
+        if (ans)
         {
             if (isAns)
             {
+                node_cur->stats_.addGuess();
+
+                MET_COUNT(MET_GUESSES_RIGHT, 1);
+                MET_DEPTH(node_cur->depth_);
+
                 printf("\n%s!\n", (lang_ == 0) ? "I guessed" : "Я угадал");
                 return AKN_OK;
             }
@@ -136,6 +193,9 @@ int Akinator::Guessing ()
         {
             if (isAns)
             {
+                MET_COUNT(MET_GUESSES_WRONG, 1);
+                MET_DEPTH(node_cur->depth_);
+
                 printf("\n%s!\n", (lang_ == 0) ? "I didn't guess" : "Я не угадал");
                 printf("%s\n",    (lang_ == 0) ? "Please add the correct answer to my base" : "Пожалуйста дополните мою базу правильным ответом");
 
@@ -155,23 +215,28 @@ int Akinator::Guessing ()
 int Akinator::CharFind ()
 {
     printf("%s: ", (lang_ == 0) ? "Enter the character you want to know about" : "Введите персонажа, о котором хотите узнать");
-    char* charname = scanChar(CHAR_SIGN);
+    Node<char*>* charnode = scanCharNode();
+    if (charnode == nullptr) return AKN_OK;
 
-    newStack(path, size_t);
-    bool found = tree_.findPath(path, charname);
-    if (not found)
+    const char* result = results_.Find(charnode, nullptr, lang_);
+    if (result == nullptr)
     {
-        printf("%s\n", (lang_ == 0) ? "No such character found" : "Такой персонаж не найден");
-        return AKN_OK;
-    }
+        Path path;
+        tree_.getPath(charnode, path);
 
-    printf("%s\b - ", charname + 1);
-    delete [] charname;
+        render_len_ = 0;
+        Render("%s\b - ", charnode->getData() + 1);
+
+        for (int i = 0; i < path.getSize() - 1; ++i)
+            printFeature(path, i);
 
-    for (int i = 0; i < path.getSize() - 1; ++i)
-        printFeature(path, i);
+        Render(".\n");
 
-    printf(".\n");
+        results_.Insert(charnode, nullptr, lang_, render_);
+        result = render_;
+    }
+
+    fputs(result, stdout);
     
     return AKN_OK;
 }
@@ -181,36 +246,40 @@ int Akinator::CharFind ()
 int Akinator::CharCmp ()
 {
     printf("%s: ", (lang_ == 0) ? "Enter the first character you want to compare" : "Введите первого персонажа, которого хотите сравнить");
-    char* char1 = scanChar(CHAR_SIGN);
-
-    newStack(path1, size_t);
-    bool found = tree_.findPath(path1, char1);
-    if (not found)
-    {
-        printf("%s\n", (lang_ == 0) ? "No such character found" : "Такой персонаж не найден");
-        return AKN_OK;
-    }
+    Node<char*>* charnode1 = scanCharNode();
+    if (charnode1 == nullptr) return AKN_OK;
 
     printf("%s: ", (lang_ == 0) ? "Enter the second character you want to compare" : "Введите второго персонажа, которого хотите сравнить");
-    char* char2 = scanChar(CHAR_SIGN);
+    Node<char*>* charnode2 = scanCharNode();
+    if (charnode2 == nullptr) return AKN_OK;
 
-    newStack(path2, size_t);
-    found = tree_.findPath(path2, char2);
-    if (not found)
+    const char* result = results_.Find(charnode1, charnode2, lang_);
+    if (result != nullptr)
     {
-        printf("%s\n", (lang_ == 0) ? "No such character found" : "Такой персонаж не найден");
+        fputs(result, stdout);
         return AKN_OK;
     }
 
+    const char* char1 = charnode1->getData();
+    const char* char2 = charnode2->getData();
+
+    Path path1;
+    tree_.getPath(charnode1, path1);
+
+    Path path2;
+    tree_.getPath(charnode2, path2);
+
     size_t i1 = 0;
     size_t i2 = 0;
 
-    if ((Node<char*>*)path1[i1 + 1] != (Node<char*>*)path2[i2 + 1])
-        printf("\n%s\b %s %s\b %s", char1 + 1, (lang_ == 0) ? "and" : "и", char2 + 1, (lang_ == 0) ? "are not alike" : "ничем не схожи");
+    render_len_ = 0;
+
+    if (path1.getId(i1 + 1) != path2.getId(i2 + 1))
+        Render("\n%s\b %s %s\b %s", char1 + 1, (lang_ == 0) ? "and" : "и", char2 + 1, (lang_ == 0) ? "are not alike" : "ничем не схожи");
     else
     {
-        printf("\n%s\b %s %s\b %s ", char1 + 1, (lang_ == 0) ? "and" : "и", char2 + 1, (lang_ == 0) ? "are similar to that" : "схожи тем, что");
-        while (((Node<char*>*)path1[i1 + 1] == (Node<char*>*)path2[i2 + 1]) && (i1 < path1.getSize() - 1) && (i2 < path2.getSize() - 1))
+        Render("\n%s\b %s %s\b %s ", char1 + 1, (lang_ == 0) ? "and" : "и", char2 + 1, (lang_ == 0) ? "are similar to that" : "схожи тем, что");
+        while ((i1 < path1.getSize() - 1) && (i2 < path2.getSize() - 1) && (path1.getId(i1 + 1) == path2.getId(i2 + 1)))
         {
             printFeature(path1, i1);
 
@@ -218,327 +287,1090 @@ int Akinator::CharCmp ()
             ++i2;
         }
     }
-    printf("\n");
+    Render("\n");
 
-    printf("%s %s\b %s ", (lang_ == 0) ? "but" : "но", char1 + 1, (lang_ == 0) ? "differs in that" : "отличается тем, что");
+    Render("%s %s\b %s ", (lang_ == 0) ? "but" : "но", char1 + 1, (lang_ == 0) ? "differs in that" : "отличается тем, что");
     for (; i1 < path1.getSize() - 1; ++i1)
         printFeature(path1, i1);
 
-    printf(",\n");
+    Render(",\n");
 
-    printf("%s %s\b %s ", (lang_ == 0) ? "and" : "а", char2 + 1, (lang_ == 0) ? "differs in that" : "отличается тем, что");
+    Render("%s %s\b %s ", (lang_ == 0) ? "and" : "а", char2 + 1, (lang_ == 0) ? "differs in that" : "отличается тем, что");
     for (; i2 < path2.getSize() - 1; ++i2)
         printFeature(path2, i2);
 
-    printf(".\n");
+    Render(".\n");
 
-    delete [] char1;
-    delete [] char2;
+    results_.Insert(charnode1, charnode2, lang_, render_);
+    fputs(render_, stdout);
 
     return AKN_OK;
 }
 
 //------------------------------------------------------------------------------
 
-int Akinator::scanNum (int start, int end)
+int Akinator::FeatureFind ()
 {
-    assert(start < end);
+    printf("%s: ", (lang_ == 0) ? "Enter a word from the feature" : "Введите слово из признака");
+    char* word = scanChar(FEAT_SIGN);
 
-    int num = 0;
-    char str[MAX_STR_LEN] = "";
-    char* endstr = (char*)"";
+    bool paged = (mounts_ != 0);
+    fetchAll();
 
-    char* err = fgets(str, MAX_STR_LEN - 2, stdin);
-    num = strtol(str, &endstr, 20);
+    void* found[MAX_FOUND_FEATURES] = {};
+    size_t num = features_.Find(word + 1, strlen(word) - 2, true, found, MAX_FOUND_FEATURES);
 
-    while ((endstr[0] != '\n') || (num < start) || (num > end) || !err)
+    delete [] word;
+
+    if (num == 0)
     {
-        printf("%s: ", (lang_ == 0) ? "Try again" : "Попробуйте снова");
-        err = fgets(str, 18, stdin);
-        num = strtol(str, &endstr, 20);
+        printf("%s\n", (lang_ == 0) ? "No such features found" : "Такие признаки не найдены");
+        if (paged) evictPages();
+        return AKN_OK;
     }
 
-    return num;
+    for (size_t i = 0; (i < num) && (i < MAX_FOUND_FEATURES); ++i)
+    {
+        Node<char*>* feature = (Node<char*>*)found[i];
+
+        printf("\n%s\b:\n", feature->getData() + 1);
+
+        printf("\t%s: ", (lang_ == 0) ? "yes" : "да");
+        printLeaves(feature->right_);
+
+        printf("\t%s: ", (lang_ == 0) ? "no" : "нет");
+        printLeaves(feature->left_);
+    }
+
+    if (num > MAX_FOUND_FEATURES)
+        printf("%s %lu\n", (lang_ == 0) ? "Features not shown:" : "Не показано признаков:", num - MAX_FOUND_FEATURES);
+
+    if (paged) evictPages();
+
+    return AKN_OK;
 }
 
 //------------------------------------------------------------------------------
 
-bool Akinator::scanAns ()
+int Akinator::Import ()
 {
-    char ans[MAX_STR_LEN] = "";
+    printf("%s: ", (lang_ == 0) ? "Enter the name of the file with characters" : "Введите имя файла с персонажами");
 
-    char* err = fgets(ans, MAX_STR_LEN - 2, stdin);
-    ans[0] = toupper(ans[0]);
+    char recname[MAX_STR_LEN] = "";
+    if (not scanFilename(recname)) return AKN_OK;
 
-    while ((ans[0] != 'Y') && (ans[0] != 'N') || (ans[1] != '\n') || !err)
+    Text records(recname);
+
+    size_t added      = 0;
+    size_t duplicates = 0;
+    size_t unresolved = 0;
+    size_t rejected   = 0;
+
+    for (size_t i = 0; i < records.num_; ++i)
     {
-        printf("%s [Y/n]? ", (lang_ == 0) ? "Try again" : "Попробуйте снова");
-        err = fgets(ans, MAX_STR_LEN - 2, stdin);
-        ans[0] = toupper(ans[0]);
+        if (records.lines_[i].len == 0) continue;
+
+        int rec_err = importRecord(records.lines_[i].str);
+
+        if (rec_err == AKN_OK)
+            ++added;
+        else if (rec_err == AKN_RECORD_DUPLICATE)
+            ++duplicates;
+        else
+        {
+            if (rec_err == AKN_RECORD_UNRESOLVED)
+                ++unresolved;
+            else
+                ++rejected;
+
+            printf("%s %lu: %s\n", (lang_ == 0) ? "Line" : "Строка", i + 1, akn_errstr[rec_err + 1]);
+        }
     }
 
-    return ((ans[0] == 'Y') ? 1 : 0);
+    if (added != 0)
+    {
+        saveBase();
+    }
+
+    printf("%s: %lu, ", (lang_ == 0) ? "Added"      : "Добавлено", added);
+    printf("%s: %lu, ", (lang_ == 0) ? "duplicates" : "повторов",  duplicates);
+    printf("%s: %lu, ", (lang_ == 0) ? "unresolved" : "без ответа", unresolved);
+    printf("%s: %lu\n", (lang_ == 0) ? "rejected"   : "отклонено", rejected);
+
+    return AKN_OK;
 }
 
 //------------------------------------------------------------------------------
 
-char* Akinator::scanChar (char c)
+int Akinator::importRecord (char* record)
 {
-    char* charname = new char [MAX_STR_LEN] {};
-    charname[0] = c;
+    assert(record != nullptr);
 
-    char* err = fgets(charname + 1, MAX_STR_LEN - 2, stdin);
-    assert(err);
+    RecordFeature feats[MAX_RECORD_FEATURES] = {};
+    size_t num = 0;
 
-    size_t len = strlen(charname);
-    assert(len);
-    charname[len - 1] = c;
+    char* name = record;
+    char* cur  = record;
 
-    return charname;
-}
+    while (*cur != '\0')
+    {
+        char  sign  = CHAR_SIGN;
+        char* token = cur;
 
-//------------------------------------------------------------------------------
+        if (cur != name)
+        {
+            if (((*cur != '+') && (*cur != '-')) || (num == MAX_RECORD_FEATURES)) return AKN_WRONG_SYNTAX_RECORD;
 
-inline void Akinator::printFeature (const Stack<size_t>& path, size_t item)
-{
-    if (((Node<char*>*)path[item])->left_ == (Node<char*>*)path[item + 1])
-        printf("%s ", (lang_ == 0) ? "not" : "не");
-    else if (((Node<char*>*)path[item])->right_ != (Node<char*>*)path[item + 1])
-        assert(0);
+            feats[num].ans  = (*cur == '+');
+            feats[num].data = ++token;
+            ++num;
+
+            sign = FEAT_SIGN;
+        }
+
+        if (*token != sign) return AKN_WRONG_SYNTAX_RECORD;
+
+        char* end = strchr(token + 1, sign);
+        if ((end == nullptr) || (end == token + 1) || (end - token + 2 > MAX_STR_LEN)) return AKN_WRONG_SYNTAX_RECORD;
+
+        cur = end + 1;
+        if ((*cur != '\0') && not isspace((unsigned char)*cur)) return AKN_WRONG_SYNTAX_RECORD;
 
-    printf("%s\b", ((Node<char*>*)path[item])->getData() + 1);
-    if (item != path.getSize() - 2) printf(", ");
+        if (*cur != '\0') *cur++ = '\0';
+        while (isspace((unsigned char)*cur)) ++cur;
+    }
+
+    if (strlen(name) < 3) return AKN_WRONG_SYNTAX_RECORD;
+
+    return mergeRecord(name, feats, num);
 }
 
 //------------------------------------------------------------------------------
 
-int Akinator::addAns (Node<char*>* node_cur)
+int Akinator::Merge ()
 {
-    assert(node_cur != nullptr);
+    printf("%s: ", (lang_ == 0) ? "Enter the name of the base to merge" : "Введите имя базы для слияния");
 
-    printf("%s: ", (lang_ == 0) ? "Enter your character" : "Введите вашего персонажа");
-    char* newchar = scanChar(CHAR_SIGN);
+    char basename[MAX_STR_LEN] = "";
+    if (not scanFilename(basename)) return AKN_OK;
+
+    Tree<char*> other((char*)"merged", basename);
 
-    newStack(path, size_t);
-    if (tree_.findPath(path, newchar))
+    int tree_err = other.getErrCode();
+    if (tree_err == TREE_OK) tree_err = other.FetchAll();
+    if (tree_err)
     {
-        printf("%s: %s\b - ", (lang_ == 0) ? "Such a character already exists" : "Такой персонаж уже есть", newchar + 1);
-        for (int i = 0; i < path.getSize() - 1; ++i)
-            printFeature(path, i);
-        printf(".\n");
+        printf("%s: %s\n", (lang_ == 0) ? "Wrong base" : "Неверная база", tree_errstr[tree_err + 1]);
+        return AKN_OK;
+    }
 
+    if (checkBase(other))
+    {
+        printf("%s: %s\n", (lang_ == 0) ? "Wrong base" : "Неверная база", akn_errstr[state_ + 1]);
+        state_ = AKN_OK;
         return AKN_OK;
     }
 
-    char oldchar[MAX_STR_LEN] = "";
-    strcpy(oldchar, node_cur->getData() + 1);
-    oldchar[strlen(oldchar) - 1] = '\0';
+    size_t begin = 0;
+    size_t end   = 0;
+    other.leafRange(other.root_, begin, end);
 
-    printf("%s %s от %s: ", (lang_ == 0) ? "Enter a characteristic that distinguishes" : "Введите признак отличающий", newchar, oldchar);
-    char* feature = scanChar(FEAT_SIGN);
+    size_t added      = 0;
+    size_t duplicates = 0;
+    size_t unresolved = 0;
+    size_t rejected   = 0;
 
-    Node<char*>* prevNode = node_cur->prev_;
+    size_t capacity = MAX_RECORD_FEATURES;
+    RecordFeature* feats = new RecordFeature [capacity];
 
-    Node<char*>* featureNode = new Node<char*>;
-    featureNode->prev_ = prevNode;
+    for (size_t i = begin; i < end; ++i)
+    {
+        Node<char*>* leaf = other.getLeaf(i);
+        size_t num = leaf->depth_;
 
-    featureNode->setData(feature);
+        if (num > capacity)
+        {
+            delete [] feats;
+            capacity = num * 2;
+            feats = new RecordFeature [capacity];
+        }
 
-    if (prevNode != nullptr)
-        if (node_cur == prevNode->right_)
-            prevNode->right_ = featureNode;
-        else
-            prevNode->left_ = featureNode;
-    else
-        tree_.root_ = featureNode;
+        Node<char*>* child = leaf;
+        for (size_t k = num; k > 0; --k)
+        {
+            Node<char*>* node = child->prev_;
 
-    Node<char*>* newcharNode = new Node<char*>;
-    newcharNode->prev_ = featureNode;
-    node_cur->prev_    = featureNode;
+            feats[k - 1].data = node->getData();
+            feats[k - 1].ans  = (node->right_ == child);
+            feats[k - 1].used = false;
 
-    newcharNode->setData(newchar);
+            child = node;
+        }
 
-    featureNode->right_ = newcharNode;
-    featureNode->left_  = node_cur;
+        int rec_err = mergeRecord(leaf->getData(), feats, num);
 
-    delete[] feature;
-    delete[] newchar;
+        if (rec_err == AKN_OK)
+            ++added;
+        else if (rec_err == AKN_RECORD_DUPLICATE)
+            ++duplicates;
+        else
+        {
+            if (rec_err == AKN_RECORD_UNRESOLVED)
+                ++unresolved;
+            else
+                ++rejected;
 
-    featureNode->recountDepth();
+            printf("%s\b: %s\n", leaf->getData() + 1, akn_errstr[rec_err + 1]);
+        }
+    }
 
-    printf("\n%s?\n",    (lang_ == 0) ? "Save to the base" : "Сохранить в базу");
-    printf("%s [Y/n]? ", (lang_ == 0) ? "Answer"           : "Ответ");
-    if (scanAns())
-        tree_.Write(filename_);
+    delete [] feats;
+
+    if (added != 0)
+    {
+        saveBase();
+    }
+
+    printf("%s: %lu, ", (lang_ == 0) ? "Added"      : "Добавлено", added);
+    printf("%s: %lu, ", (lang_ == 0) ? "duplicates" : "повторов",  duplicates);
+    printf("%s: %lu, ", (lang_ == 0) ? "unresolved" : "без ответа", unresolved);
+    printf("%s: %lu\n", (lang_ == 0) ? "rejected"   : "отклонено", rejected);
 
     return AKN_OK;
 }
 
 //------------------------------------------------------------------------------
 
-int Akinator::checkBase (Node<char*>* node_cur)
+int Akinator::mergeRecord (char* name, RecordFeature* feats, size_t num)
 {
-    assert(node_cur != nullptr);
+    assert(name != nullptr);
 
-    size_t len = strlen(node_cur->getData());
-    
-    if ((node_cur->left_ == nullptr) && (node_cur->right_ == nullptr))
-        if ((node_cur->getData()[0] != CHAR_SIGN) || (node_cur->getData()[len - 1] != CHAR_SIGN))
-        {
-            path2badnode_.Push(node_cur->getData());
-            return AKN_WRONG_SYNTAX_TREE_LEAF;
-        }
-        else;
-    else
-    if ((node_cur->left_ != nullptr) && (node_cur->right_ != nullptr))
-        if ((node_cur->getData()[0] != FEAT_SIGN) || (node_cur->getData()[len - 1] != FEAT_SIGN))
-        {
-            path2badnode_.Push(node_cur->getData());
-            return AKN_WRONG_SYNTAX_TREE_NODE;
-        }
-        else;
-    else
+    size_t len = strlen(name);
+
+    size_t slots_num = RECORD_SLOTS;
+    while (slots_num < 2 * num) slots_num *= 2;
+
+    SmallStack<int, RECORD_SLOTS> slots;
+    for (size_t i = 0; i < slots_num; ++i)
     {
-        path2badnode_.Push(node_cur->getData());
-        return AKN_WRONG_TREE_ONE_CHILD;
+        AKN_ASSERTOK(slots.Push(-1), AKN_NO_MEMORY, AKN_NO_MEMORY);
     }
 
-    int err = AKN_OK;
+    for (size_t i = 0; i < num; ++i)
+    {
+        size_t slot = recordSlot(feats[i].data, feats, slots);
+        if (slots[slot] == -1) slots[slot] = (int)i;
+    }
 
-    if (node_cur->right_ != nullptr)
-        err = checkBase(node_cur->right_);
-    state_ = err;
+    Node<char*>* oldnode = (Node<char*>*)names_.Find(name + 1, len - 2);
+    while ((oldnode == nullptr) && fetchLabel(name, matchName))
+        oldnode = (Node<char*>*)names_.Find(name + 1, len - 2);
 
-    if (err)
+    if (oldnode != nullptr)
     {
-        path2badnode_.Push(node_cur->getData());
-        return err;
+        for (Node<char*>* child = oldnode; child->prev_ != nullptr; child = child->prev_)
+        {
+            int feat = slots[recordSlot(child->prev_->getData(), feats, slots)];
+            if ((feat != -1) && (feats[feat].ans != (child->prev_->right_ == child))) return AKN_RECORD_CONFLICT;
+        }
+
+        return AKN_RECORD_DUPLICATE;
+    }
+
+    Node<char*>* node_cur = tree_.root_;
+    while (true)
+    {
+        if (node_cur->isMount() && fetchShard(node_cur)) return AKN_SHARD_NOT_FOUND;
+        if (node_cur->right_ == nullptr) break;
+
+        int feat = slots[recordSlot(node_cur->getData(), feats, slots)];
+        if (feat == -1) return AKN_RECORD_UNRESOLVED;
+
+        feats[feat].used = true;
+        node_cur = (feats[feat].ans) ? node_cur->right_ : node_cur->left_;
     }
 
-    if (node_cur->left_ != nullptr)
-        err = checkBase(node_cur->left_);
-    state_ = err;
+    size_t feat = 0;
+    while ((feat < num) && feats[feat].used) ++feat;
 
-    if (err) path2badnode_.Push(node_cur->getData());
+    if (feat == num) return AKN_RECORD_NO_FEATURE;
 
-    return err;
+    results_.Invalidate(node_cur);
+
+    Node<char*>* featureNode = tree_.Branch(node_cur, feats[feat].data, name, feats[feat].ans);
+    Node<char*>* leaf = (feats[feat].ans) ? featureNode->right_ : featureNode->left_;
+
+    names_   .Insert(name + 1, len - 2, leaf);
+    features_.Insert(feats[feat].data + 1, strlen(feats[feat].data) - 2, featureNode);
+
+    return AKN_OK;
 }
 
 //------------------------------------------------------------------------------
 
-void Akinator::printGraphBase (const char* graphname)
+int Akinator::Export ()
 {
-    FILE* graph = fopen(graphname, "w");
-    assert(graph != nullptr);
+    printf("%s: ", (lang_ == 0) ? "Enter the feature of the subtree" : "Введите признак поддерева");
+    char* feature = scanChar(FEAT_SIGN);
 
-    fprintf(graph, "digraph G{\n" "rankdir = HR;\n node[shape=box];\n");
+    Node<char*>* sub = findFeature(feature);
+    while ((sub == nullptr) && fetchLabel(feature, matchFeature))
+        sub = findFeature(feature);
 
-    printGraphNode(graph, tree_.root_);
+    delete [] feature;
 
-    fprintf(graph, "\tlabelloc=\"t\";"
-                  "\tlabel=\"Akinator base: %s\";"
-                  "}\n", tree_.name_);
+    if (sub == nullptr)
+    {
+        printf("%s\n", (lang_ == 0) ? "No such feature found" : "Такой признак не найден");
+        return AKN_OK;
+    }
 
-    fclose(graph);
+    printf("%s: ", (lang_ == 0) ? "Enter the name of the file for the subtree" : "Введите имя файла для поддерева");
 
-    char command[128] = "";
+    char shardname[MAX_STR_LEN] = "";
+    char* err = fgets(shardname, MAX_STR_LEN, stdin);
+    assert(err);
+    shardname[strcspn(shardname, "\r\n")] = '\0';
 
-#if defined(WIN32)
+    if (tree_.Export(sub, shardname))
+    {
+        printf("%s\n", (lang_ == 0) ? "Failed to write the file" : "Не удалось записать файл");
+        return AKN_OK;
+    }
 
-    sprintf(command, "win_iconv -f 1251 -t UTF8 \"%s\" > \"new%s\"", graphname, graphname);
+    printf("\n%s?\n",    (lang_ == 0) ? "Mount the file in place of the subtree" : "Подключить файл вместо поддерева");
+    printf("%s [Y/n]? ", (lang_ == 0) ? "Answer"                                : "Ответ");
+    if (scanAns())
+    {
+        tree_.Mount(sub, shardname);
+        saveBase();
+    }
 
-    int err = system(command);
+    return AKN_OK;
+}
 
-    char* truename = new char[128] {};
-    strcpy(truename, graphname);
+//------------------------------------------------------------------------------
 
-    sprintf(command, "dot -Tpng -o %s.png new%s", GetTrueFileName((char*)truename), graphname);
-    if (!err) err = system(command);
+int Akinator::Pack ()
+{
+    printf("%s: ", (lang_ == 0) ? "Enter the name of the file for the packed base" : "Введите имя файла для сжатой базы");
 
-    sprintf(command, "del new%s", graphname);
-    if (!err) err = system(command);
+    char packname[MAX_STR_LEN] = "";
+    char* err = fgets(packname, MAX_STR_LEN, stdin);
+    assert(err);
+    packname[strcspn(packname, "\r\n")] = '\0';
 
-    sprintf(command, "start %s.png", truename);
+    if (tree_.Pack(packname))
+    {
+        printf("%s\n", (lang_ == 0) ? "Failed to write the file" : "Не удалось записать файл");
+        return AKN_OK;
+    }
 
-#elif defined(__linux__)
+    // pages are loaded to pack the base
+    if (mounts_ != 0) buildIndex();
 
-    sprintf(command, "iconv -f UTF8 -t UTF8 \"%s\" -o \"new%s\"", graphname, graphname);
+    printf("%s\n", (lang_ == 0) ? "The base is packed" : "База сжата");
 
-    int err = system(command);
+    return AKN_OK;
+}
 
-    char* truename = new char[128] {};
-    strcpy(truename, graphname);
+//------------------------------------------------------------------------------
 
-    sprintf(command, "dot -Tpng -o %s.png new%s", GetTrueFileName((char*)truename), graphname);
-    if (!err) err = system(command);
+int Akinator::Report ()
+{
+    const Metrics& metrics = GetMetrics();
 
-    sprintf(command, "rm new%s", graphname);
-    if (!err) err = system(command);
+    printf("\n%-12s %10s %12s %12s %12s\n", (lang_ == 0) ? "Operation" : "Операция", "count", "p50, ms", "p99, ms", "max, ms");
 
-    sprintf(command, "eog %s.png", truename);
+    for (int op = 0; op < MET_OPS_NUM; ++op)
+    {
+        const Histogram& hist = metrics.getLatency(op);
 
-#else
-#error Program is only supported by linux or windows platforms
-#endif
+        printf("%-12s %10llu %12.3f %12.3f %12.3f\n", met_opstr[op], hist.getCount(),
+               hist.getQuantile(0.5) / 1e6, hist.getQuantile(0.99) / 1e6, hist.getMax() / 1e6);
+    }
 
-    if (!err) err = system(command);
+    printf("\n%-12s %12s %10s %12s %12s\n", (lang_ == 0) ? "Memory" : "Память", "bytes", "blocks", "peak", "allocations");
 
-    delete[] truename;
+    for (int mem = 0; mem < MEM_NUM; ++mem)
+    {
+        long long bytes  = 0;
+        long long blocks = 0;
+        long long peak   = 0;
+        unsigned long long allocs = 0;
+
+        metrics.getMemory(mem, bytes, blocks, peak, allocs);
+
+        printf("%-12s %12lld %10lld %12lld %12llu\n", met_memstr[mem], bytes, blocks, peak, allocs);
+    }
+
+    if (metrics.Write(METRICS_FILENAME))
+    {
+        printf("%s\n", (lang_ == 0) ? "Failed to write the file" : "Не удалось записать файл");
+        return AKN_OK;
+    }
+
+    printf("%s %s\n", (lang_ == 0) ? "All metrics are written to" : "Все метрики записаны в", METRICS_FILENAME);
+
+    return AKN_OK;
 }
 
 //------------------------------------------------------------------------------
 
-void Akinator::printGraphNode (FILE* graph, Node<char*>* node_cur)
+Node<char*>* Akinator::findFeature (const char* feature)
 {
-    assert(graph != nullptr);
+    assert(feature != nullptr);
 
-    if (node_cur->right_ == nullptr && node_cur->left_ == nullptr)
-        fprintf(graph, "\t \"%s\" [shape = box, style = filled, color = black, fillcolor = orange]\n", node_cur->getData());
-    else
-        fprintf(graph, "\t \"%s\" [shape = box, style = filled, color = black, fillcolor = lightskyblue]\n", node_cur->getData());
+    const char* word = feature + 1;
+
+    size_t len = 0;
+    while ((word[len] != '\0') && (((unsigned char)word[len] >= 0x80) || isalnum(word[len]))) ++len;
+
+    if (len == 0) return nullptr;
+
+    void* found[MAX_FOUND_FEATURES] = {};
+    size_t num = features_.Find(word, len, false, found, MAX_FOUND_FEATURES);
+
+    void** all = found;
+    if (num > MAX_FOUND_FEATURES)
+    {
+        all = new void* [num];
+        features_.Find(word, len, false, all, num);
+    }
 
-    if (node_cur->left_ != nullptr)
-        fprintf(graph, "\t \"%s\" -> \"%s\" [label=\"No\"]\n", node_cur->getData(), node_cur->left_->getData());
+    Node<char*>* sub = nullptr;
+    for (size_t i = 0; (i < num) && (sub == nullptr); ++i)
+        if (strcmp(((Node<char*>*)all[i])->getData(), feature) == 0)
+            sub = (Node<char*>*)all[i];
 
-    if (node_cur->right_ != nullptr)
-        fprintf(graph, "\t \"%s\" -> \"%s\" [label=\"Yes\"]\n", node_cur->getData(), node_cur->right_->getData());
+    if (all != found) delete [] all;
 
-    if (node_cur->left_  != nullptr) printGraphNode(graph, node_cur->left_);
-    if (node_cur->right_ != nullptr) printGraphNode(graph, node_cur->right_);
+    return sub;
 }
 
 //------------------------------------------------------------------------------
 
-void Akinator::PrintError (const char* logname, const char* file, int line, const char* function, int err)
+int Akinator::fetchShard (Node<char*>* node_cur)
 {
-    assert(function != nullptr);
-    assert(logname  != nullptr);
-    assert(file     != nullptr);
-
-    FILE* log = fopen(logname, "a");
-    assert(log != nullptr);
-
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
+    assert(node_cur != nullptr);
 
-    fprintf(log, "###############################################################################\n");
-    fprintf(log, "TIME: %d-%02d-%02d %02d:%02d:%02d\n\n",
-            tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
-    fprintf(log, "ERROR: file %s  line %d  function %s\n\n", file, line, function);
-    fprintf(log, "%s\n", akn_errstr[err + 1]);
+    size_t evictions = tree_.getEvictions();
 
-    if (path2badnode_.getSize() != 0)
+    int err = tree_.Fetch(node_cur);
+    if (err)
     {
-        fprintf(log, "%s", path2badnode_.getName());
-        for (int i = path2badnode_.getSize() - 1; i > -1; --i)
-            fprintf(log, " -> [%s]", path2badnode_[i]);
+        printf("%s: %s\n", node_cur->getData(), tree_errstr[err + 1]);
+        return err;
+    }
 
-        fprintf(log, "\n");
+    // evicted pages leave dangling nodes in the indexes and the results
+    if (tree_.getEvictions() != evictions)
+    {
+        results_.Clean();
+        buildIndex();
+        return AKN_OK;
     }
-    fprintf(log, "You can look tree dump in %s\n", DUMP_PICT_NAME);
-    fclose(log);
 
-    ////
+    --mounts_;
+    indexNode(node_cur);
+
+    return AKN_OK;
+}
+
+//------------------------------------------------------------------------------
+
+int Akinator::fetchAll ()
+{
+    if (mounts_ == 0) return AKN_OK;
+
+    int err = tree_.FetchAll();
+    if (err) printf("%s\n", tree_errstr[err + 1]);
+
+    buildIndex();
+
+    return err;
+}
+
+//------------------------------------------------------------------------------
+
+bool Akinator::fetchLabel (const char* label, bool (*match)(const char* line, const char* label))
+{
+    assert(label != nullptr);
+
+    if (mounts_ == 0) return false;
+
+    Node<char*>* page = tree_.findPage(label, match);
+
+    return (page != nullptr) && (fetchShard(page) == AKN_OK);
+}
+
+//------------------------------------------------------------------------------
+
+void Akinator::evictPages ()
+{
+    size_t evictions = tree_.getEvictions();
+
+    tree_.Evict();
+
+    if (tree_.getEvictions() != evictions)
+    {
+        results_.Clean();
+        buildIndex();
+    }
+}
+
+//------------------------------------------------------------------------------
+
+bool Akinator::scanFilename (char* filename)
+{
+    assert(filename != nullptr);
+
+    char* err = fgets(filename, MAX_STR_LEN, stdin);
+    assert(err);
+    filename[strcspn(filename, "\r\n")] = '\0';
+
+    FILE* fp = fopen(filename, "r");
+    if (fp == nullptr)
+    {
+        printf("%s\n", (lang_ == 0) ? "File is not found" : "Файл не найден");
+        return false;
+    }
+
+    size_t size = CountSize(fp);
+    fclose(fp);
+
+    if (size == 0)
+    {
+        printf("%s\n", (lang_ == 0) ? "File is empty" : "Файл пуст");
+        return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+void Akinator::printLeaves (Node<char*>* node_cur)
+{
+    assert(node_cur != nullptr);
+
+    size_t begin = 0;
+    size_t end   = 0;
+    tree_.leafRange(node_cur, begin, end);
+
+    for (size_t id = begin; id < end; ++id)
+    {
+        printf("%s\b", tree_.getLeaf(id)->getData() + 1);
+        printf("%s", (id + 1 < end) ? ", " : ".\n");
+    }
+}
+
+//------------------------------------------------------------------------------
+
+int Akinator::scanNum (int start, int end)
+{
+    assert(start < end);
+
+    int num = 0;
+    char str[MAX_STR_LEN] = "";
+    char* endstr = (char*)"";
+
+    char* err = fgets(str, MAX_STR_LEN - 2, stdin);
+    num = strtol(str, &endstr, 10);
+
+    while ((endstr[0] != '\n') || (num < start) || (num > end) || !err)
+    {
+        printf("%s: ", (lang_ == 0) ? "Try again" : "Попробуйте снова");
+        err = fgets(str, 18, stdin);
+        num = strtol(str, &endstr, 10);
+    }
+
+    return num;
+}
+
+//------------------------------------------------------------------------------
+
+bool Akinator::scanAns ()
+{
+    char ans[MAX_STR_LEN] = "";
+
+    char* err = fgets(ans, MAX_STR_LEN - 2, stdin);
+    ans[0] = toupper(ans[0]);
+
+    while ((ans[0] != 'Y') && (ans[0] != 'N') || (ans[1] != '\n') || !err)
+    {
+        printf("%s [Y/n]? ", (lang_ == 0) ? "Try again" : "Попробуйте снова");
+        err = fgets(ans, MAX_STR_LEN - 2, stdin);
+        ans[0] = toupper(ans[0]);
+    }
+
+    return ((ans[0] == 'Y') ? 1 : 0);
+}
+
+//------------------------------------------------------------------------------
+
+char* Akinator::scanChar (char c)
+{
+    char* charname = new char [MAX_STR_LEN] {};
+    charname[0] = c;
+
+    char* err = fgets(charname + 1, MAX_STR_LEN - 2, stdin);
+    assert(err);
+
+    size_t len = strlen(charname);
+    assert(len);
+    charname[len - 1] = c;
+
+    return charname;
+}
+
+//------------------------------------------------------------------------------
+
+Node<char*>* Akinator::scanCharNode ()
+{
+    char* charname = scanChar(CHAR_SIGN);
+    size_t len = strlen(charname);
+
+    Node<char*>* charnode = (Node<char*>*)names_.Find(charname + 1, len - 2);
+    while ((charnode == nullptr) && fetchLabel(charname, matchName))
+        charnode = (Node<char*>*)names_.Find(charname + 1, len - 2);
+
+    if (charnode == nullptr)
+    {
+        NameMatch matches[MAX_MATCHES] = {};
+        size_t num = names_.Search(charname + 1, len - 2, MAX_TYPOS, matches, MAX_MATCHES);
+
+        if (num == 0)
+            printf("%s\n", (lang_ == 0) ? "No such character found" : "Такой персонаж не найден");
+        else
+        {
+            printf("%s:\n", (lang_ == 0) ? "No such character found, maybe you mean" : "Такой персонаж не найден, возможно вы имели в виду");
+            for (size_t i = 0; i < num; ++i)
+                printf("\t[%lu]: %s\b \n", i + 1, ((Node<char*>*)matches[i].data)->getData() + 1);
+            printf("\t[0]: %s\n", (lang_ == 0) ? "None of them" : "Никого из них");
+            printf((lang_ == 0) ? "Enter a number: " : "Введите число: ");
+
+            int choice = scanNum(0, num);
+            if (choice != 0) charnode = (Node<char*>*)matches[choice - 1].data;
+        }
+    }
+
+    delete [] charname;
+
+    return charnode;
+}
+
+//------------------------------------------------------------------------------
+
+inline void Akinator::printFeature (const Path& path, size_t item)
+{
+    if (not path.getDir(item))
+        Render("%s ", (lang_ == 0) ? "not" : "не");
+
+    Render("%s\b", tree_.getNode(path.getId(item))->getData() + 1);
+    if (item != path.getSize() - 2) Render(", ");
+}
+
+//------------------------------------------------------------------------------
+
+void Akinator::Render (const char* format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    int len = vsnprintf(render_ + render_len_, render_cap_ - render_len_, format, args);
+    va_end(args);
+
+    AKN_ASSERTOK((len < 0), AKN_NOT_OK);
+
+    if (render_len_ + len >= render_cap_)
+    {
+        size_t capacity = (render_cap_ == 0) ? MAX_STR_LEN * 4 : render_cap_;
+        while (render_len_ + len >= capacity) capacity *= 2;
+
+        char* temp = new (std::nothrow) char [capacity];
+        AKN_ASSERTOK((temp == nullptr), AKN_NO_MEMORY);
+
+        if (render_len_ != 0) memcpy(temp, render_, render_len_);
+
+        delete [] render_;
+        render_     = temp;
+        render_cap_ = capacity;
+
+        va_start(args, format);
+        vsnprintf(render_ + render_len_, render_cap_ - render_len_, format, args);
+        va_end(args);
+    }
+
+    render_len_ += len;
+}
+
+//------------------------------------------------------------------------------
+
+int Akinator::addAns (Node<char*>* node_cur)
+{
+    assert(node_cur != nullptr);
+
+    printf("%s: ", (lang_ == 0) ? "Enter your character" : "Введите вашего персонажа");
+    char* newchar = scanChar(CHAR_SIGN);
+
+    Node<char*>* oldnode = (Node<char*>*)names_.Find(newchar + 1, strlen(newchar) - 2);
+
+    if ((oldnode == nullptr) && (mounts_ != 0))
+    {
+        // loaded pages may unload the page of the guess, so it is found again by its path
+        Path guess;
+        if (tree_.getPath(node_cur, guess))
+        {
+            delete [] newchar;
+            return AKN_NO_MEMORY;
+        }
+
+        size_t evictions = tree_.getEvictions();
+
+        while ((oldnode == nullptr) && fetchLabel(newchar, matchName))
+            oldnode = (Node<char*>*)names_.Find(newchar + 1, strlen(newchar) - 2);
+
+        if ((oldnode == nullptr) && (tree_.getEvictions() != evictions))
+        {
+            node_cur = tree_.root_;
+            for (size_t i = 1; i <= guess.getSize(); ++i)
+            {
+                if (node_cur->isMount() && fetchShard(node_cur))
+                {
+                    delete [] newchar;
+                    return AKN_OK;
+                }
+
+                if (i < guess.getSize()) node_cur = (guess.getDir(i)) ? node_cur->right_ : node_cur->left_;
+            }
+        }
+    }
+
+    if (oldnode != nullptr)
+    {
+        Path path;
+        tree_.getPath(oldnode, path);
+
+        render_len_ = 0;
+        Render("%s: %s\b - ", (lang_ == 0) ? "Such a character already exists" : "Такой персонаж уже есть", oldnode->getData() + 1);
+        for (int i = 0; i < path.getSize() - 1; ++i)
+            printFeature(path, i);
+        Render(".\n");
+
+        fputs(render_, stdout);
+
+        delete [] newchar;
+
+        return AKN_OK;
+    }
+
+    char oldchar[MAX_STR_LEN] = "";
+    strcpy(oldchar, node_cur->getData() + 1);
+    oldchar[strlen(oldchar) - 1] = '\0';
+
+    printf("%s %s от %s: ", (lang_ == 0) ? "Enter a characteristic that distinguishes" : "Введите признак отличающий", newchar, oldchar);
+    char* feature = scanChar(FEAT_SIGN);
+
+    size_t begin = 0;
+    size_t end   = 0;
+    tree_.leafRange(node_cur, begin, end);
+
+    for (size_t i = begin; i < end; ++i)
+        results_.Invalidate(tree_.getLeaf(i));
+
+    Node<char*>* featureNode = tree_.Branch(node_cur, feature, newchar);
+
+    names_   .Insert(newchar + 1, strlen(newchar) - 2, featureNode->right_);
+    features_.Insert(feature + 1, strlen(feature) - 2, featureNode);
+
+    delete[] feature;
+    delete[] newchar;
+
+    printf("\n%s?\n",    (lang_ == 0) ? "Save to the base" : "Сохранить в базу");
+    printf("%s [Y/n]? ", (lang_ == 0) ? "Answer"           : "Ответ");
+    if (scanAns())
+    {
+        saveBase();
+    }
+
+    return AKN_OK;
+}
+
+//------------------------------------------------------------------------------
+
+void Akinator::saveBase ()
+{
+    tree_.Write(filename_);
+    tree_.WriteStats(statname_);
+
+    // pages are loaded to write the base, so their characters are indexed anew
+    if (mounts_ != 0) buildIndex();
+}
+
+//------------------------------------------------------------------------------
+
+void Akinator::loadStats ()
+{
+    assert(filename_ != nullptr);
+
+    statname_ = new char [strlen(filename_) + strlen(STATS_SUFFIX) + 2] {};
+    strcpy(statname_, filename_);
+    strcat(statname_, STATS_SUFFIX);
+
+    tree_.ReadStats(statname_);
+}
+
+//------------------------------------------------------------------------------
+
+void Akinator::buildIndex ()
+{
+    names_.Clean();
+    features_.Clean();
+    mounts_ = 0;
+
+    if (tree_.root_ != nullptr) indexNode(tree_.root_);
+}
+
+//------------------------------------------------------------------------------
+
+void Akinator::indexNode (Node<char*>* node_cur)
+{
+    assert(node_cur != nullptr);
+
+    if (node_cur->isMount())
+    {
+        ++mounts_;
+        return;
+    }
+
+    if ((node_cur->left_ == nullptr) && (node_cur->right_ == nullptr))
+    {
+        const char* data = node_cur->getData();
+        names_.Insert(data + 1, strlen(data) - 2, node_cur);
+    }
+    else
+    {
+        const char* data = node_cur->getData();
+        features_.Insert(data + 1, strlen(data) - 2, node_cur);
+    }
+
+    if (node_cur->right_ != nullptr) indexNode(node_cur->right_);
+    if (node_cur->left_  != nullptr) indexNode(node_cur->left_);
+}
+
+//------------------------------------------------------------------------------
+
+int Akinator::checkBase (Tree<char*>& tree)
+{
+    int node_err = AKN_OK;
+    int err = tree.Check(checkNode, &node_err);
+
+    path2badnode_ = tree.getBadPath();
+
+    if (err == TREE_OK)                   state_ = AKN_OK;
+    else if (err == TREE_WRONG_NODE_DATA) state_ = node_err;
+    else                                  state_ = AKN_INCORRECT_INPUT_SYNTAX_BASE;
+
+    return state_;
+}
+
+//------------------------------------------------------------------------------
+
+int Akinator::checkNode (Node<char*>* node_cur)
+{
+    assert(node_cur != nullptr);
+
+    if (node_cur->isMount()) return AKN_OK;
+
+    const char* data = node_cur->getData();
+    size_t      len  = node_cur->getLen();
+
+    if ((node_cur->left_ == nullptr) && (node_cur->right_ == nullptr))
+    {
+        if ((len < 2) || (data[0] != CHAR_SIGN) || (data[len - 1] != CHAR_SIGN))
+            return AKN_WRONG_SYNTAX_TREE_LEAF;
+    }
+    else
+    if ((node_cur->left_ != nullptr) && (node_cur->right_ != nullptr))
+    {
+        if ((len < 2) || (data[0] != FEAT_SIGN) || (data[len - 1] != FEAT_SIGN))
+            return AKN_WRONG_SYNTAX_TREE_NODE;
+    }
+    else return AKN_WRONG_TREE_ONE_CHILD;
+
+    return AKN_OK;
+}
+
+//------------------------------------------------------------------------------
+
+bool Akinator::matchName (const char* line, const char* name)
+{
+    assert(line != nullptr);
+    assert(name != nullptr);
+
+    size_t line_len = strlen(line);
+    size_t name_len = strlen(name);
+
+    while ((line_len != 0) && (name_len != 0))
+    {
+        unsigned int line_symb = 0;
+        unsigned int name_symb = 0;
+
+        size_t line_size = GetSymb(line, line_len, &line_symb);
+        size_t name_size = GetSymb(name, name_len, &name_symb);
+
+        if (line_symb != name_symb) return false;
+
+        line += line_size;
+        line_len -= line_size;
+        name += name_size;
+        name_len -= name_size;
+    }
+
+    return (line_len == 0) && (name_len == 0);
+}
+
+//------------------------------------------------------------------------------
+
+bool Akinator::matchFeature (const char* line, const char* feature)
+{
+    assert(line    != nullptr);
+    assert(feature != nullptr);
+
+    return strcmp(line, feature) == 0;
+}
+
+//------------------------------------------------------------------------------
+
+size_t Akinator::recordSlot (const char* feature, const RecordFeature* feats, SmallStack<int, RECORD_SLOTS>& slots)
+{
+    assert(feature != nullptr);
+    assert(feats   != nullptr);
+
+    size_t mask = slots.getSize() - 1;
+
+    size_t hash = 14695981039346656037ull;
+    for (const char* cur = feature; *cur != '\0'; ++cur)
+        hash = (hash ^ (unsigned char)*cur) * 1099511628211ull;
+
+    size_t slot = hash & mask;
+    while ((slots[slot] != -1) && (strcmp(feats[slots[slot]].data, feature) != 0))
+        slot = (slot + 1) & mask;
+
+    return slot;
+}
+
+//------------------------------------------------------------------------------
+
+int Akinator::printGraphBase ()
+{
+    printf("%s: ", (lang_ == 0) ? "Enter the feature of the subtree or nothing for the whole base" : "Введите признак поддерева или ничего для всей базы");
+    char* feature = scanChar(FEAT_SIGN);
+
+    Node<char*>* sub = tree_.root_;
+    if (strlen(feature) > 2)
+    {
+        sub = findFeature(feature);
+        while ((sub == nullptr) && fetchLabel(feature, matchFeature))
+            sub = findFeature(feature);
+    }
+
+    delete [] feature;
+
+    if (sub == nullptr)
+    {
+        printf("%s\n", (lang_ == 0) ? "No such feature found" : "Такой признак не найден");
+        return AKN_OK;
+    }
+
+    printf("%s: ", (lang_ == 0) ? "Enter the depth limit or 0 for no limit" : "Введите ограничение глубины или 0 без ограничения");
+    size_t max_depth = scanNum(0, MAX_GRAPH_DEPTH);
+
+    printf("%s:\n", (lang_ == 0) ? "Choose the format" : "Выберите формат");
+    printf("[1] %s\n", (lang_ == 0) ? "Graphviz picture" : "Картинка graphviz");
+    printf("[2] %s\n", (lang_ == 0) ? "JSON adjacency"   : "Список смежности JSON");
+    printf("%s: ", (lang_ == 0) ? "Answer" : "Ответ");
+
+    bool dot = (scanNum(1, 2) == 1);
+    const char* graphname = dot ? GRAPH_FILENAME : GRAPH_JSON_FILENAME;
+
+    if (tree_.Graph(sub, graphname, dot ? GRAPH_DOT : GRAPH_JSON, max_depth))
+    {
+        printf("%s\n", (lang_ == 0) ? "Failed to write the file" : "Не удалось записать файл");
+        return AKN_OK;
+    }
+
+    if (dot) showGraph(graphname);
+    else     printf("%s %s\n", (lang_ == 0) ? "The graph is written to" : "Граф записан в", graphname);
+
+    return AKN_OK;
+}
+
+//------------------------------------------------------------------------------
+
+void Akinator::showGraph (const char* graphname)
+{
+    assert(graphname != nullptr);
+
+    char command[128] = "";
+
+    char* truename = new char[128] {};
+    strcpy(truename, graphname);
+    GetTrueFileName(truename);
+
+#if defined(WIN32)
+
+    sprintf(command, "win_iconv -f 1251 -t UTF8 \"%s\" > \"new%s\"", graphname, graphname);
+
+    int err = system(command);
+
+    sprintf(command, "dot -Tpng -o %s.png new%s", truename, graphname);
+    if (!err) err = system(command);
+
+    sprintf(command, "del new%s", graphname);
+    if (!err) err = system(command);
+
+    sprintf(command, "start %s.png", truename);
+
+#elif defined(__linux__)
+
+    // the base is already in UTF-8, so dot reads the graph file itself
+    sprintf(command, "dot -Tpng -o \"%s.png\" \"%s\"", truename, graphname);
+
+    int err = system(command);
+
+    sprintf(command, "eog \"%s.png\"", truename);
+
+#else
+#error Program is only supported by linux or windows platforms
+#endif
+
+    if (!err) err = system(command);
+
+    delete[] truename;
+}
+
+//------------------------------------------------------------------------------
+
+void Akinator::PrintError (const char* logname, const char* file, int line, const char* function, int err)
+{
+    assert(function != nullptr);
+    assert(logname  != nullptr);
+    assert(file     != nullptr);
+
+    if (path2badnode_.getSize() == 0)
+        LogError(logname, "akinator", file, line, function, err, akn_errstr[err + 1]);
+    else
+    {
+        char   path[LOG_RECORD_SIZE] = "";
+        size_t len = 0;
+        for (int i = path2badnode_.getSize() - 1; (i > -1) && (len < LOG_RECORD_SIZE); --i)
+            len += snprintf(path + len, LOG_RECORD_SIZE - len, "%s[%s]", (len == 0) ? "" : " -> ", path2badnode_[i]);
+
+        LogWrite(LOG_ERROR, logname, "lib=akinator file=%s line=%d func=\"%s\" code=%d error=\"%s\" path=\"%s\"",
+                 file, line, function, err, akn_errstr[err + 1], path);
+    }
 
     printf (     "ERROR: file %s  line %d  function %s\n",   file, line, function);
     printf (     "%s\n\n", akn_errstr[err + 1]);
@@ -551,7 +1383,6 @@ void Akinator::PrintError (const char* logname, const char* file, int line, cons
 
         printf("\n");
     }
-    printf (     "You can look tree dump in %s\n", DUMP_PICT_NAME);
 }
 
 //------------------------------------------------------------------------------
@@ -27,11 +27,16 @@
 #endif
 
 
+#include "LogLib/Log.h"
 #include "StringLib/StringLib.h"
 #include "StackLib/Stack.h"
 #include "TreeLib/Tree.h"
+#include "IndexLib/NameIndex.h"
+#include "IndexLib/FeatureIndex.h"
+#include "IndexLib/ResultCache.h"
 
 #include <locale.h>
+#include <stdarg.h>
 
 
 //==============================================================================
@@ -54,6 +59,12 @@ enum AkinatorErrors
     AKN_WRONG_SYNTAX_TREE_LEAF                                         ,
     AKN_WRONG_SYNTAX_TREE_NODE                                         ,
     AKN_WRONG_TREE_ONE_CHILD                                           ,
+    AKN_WRONG_SYNTAX_RECORD                                            ,
+    AKN_RECORD_DUPLICATE                                               ,
+    AKN_RECORD_NO_FEATURE                                              ,
+    AKN_RECORD_CONFLICT                                                ,
+    AKN_SHARD_NOT_FOUND                                                ,
+    AKN_RECORD_UNRESOLVED                                              ,
 };
 
 char const * const akn_errstr[] =
@@ -69,27 +80,31 @@ char const * const akn_errstr[] =
     "Wrohg syntax tree leaf"                                           ,
     "Wrohg syntax tree node"                                           ,
     "Every node must have 0 or 2 children"                             ,
+    "Wrong syntax of the import record"                                ,
+    "Character of the import record already exists"                    ,
+    "No feature of the import record distinguishes the character"      ,
+    "Answers of the import record conflict with the base"              ,
+    "Shard file of the mount point is not found"                       ,
+    "Import record has no answer for a feature on its way"             ,
 };
 
 char const * const AKINATOR_LOGNAME = "akinator.log";
 
-#define BASE_CHECK if (tree_.Check ())                                                                            \
-                   {                                                                                              \
-                     tree_.Dump();                                                                                \
-                     tree_.PrintError (TREE_LOGNAME , __FILE__, __LINE__, __FUNC_NAME__, tree_.getErrCode(), -1); \
-                     exit(tree_.getErrCode());                                                                    \
-                   }                                                                                              \
-                   if (checkBase (tree_.root_))                                                                   \
-                   {                                                                                              \
-                     AKN_ASSERTOK(state_, state_);                                                                \
-                   } //
-
-#define AKN_ASSERTOK(cond, err) if (cond)                                                               \
-                                {                                                                       \
-                                  PrintError(AKINATOR_LOGNAME, __FILE__, __LINE__, __FUNC_NAME__, err); \
-                                  tree_.Dump();                                                         \
-                                  exit(err);                                                            \
-                                } //
+#define BASE_CHECK(...) if (checkBase (tree_))                                                                       \
+                        {                                                                                             \
+                          if (state_ == AKN_INCORRECT_INPUT_SYNTAX_BASE)                                              \
+                            tree_.PrintError (TREE_LOGNAME , __FILE__, __LINE__, __FUNC_NAME__, tree_.getErrCode(), -1); \
+                          else                                                                                        \
+                            PrintError (AKINATOR_LOGNAME, __FILE__, __LINE__, __FUNC_NAME__, state_);                 \
+                          return __VA_ARGS__;                                                                         \
+                        } //
+
+#define AKN_ASSERTOK(cond, err, ...) if (cond)                                                               \
+                                     {                                                                       \
+                                       PrintError(AKINATOR_LOGNAME, __FILE__, __LINE__, __FUNC_NAME__, err); \
+                                       state_ = err;                                                         \
+                                       return __VA_ARGS__;                                                   \
+                                     } //
 
 
 //==============================================================================
@@ -99,13 +114,27 @@ char const * const AKINATOR_LOGNAME = "akinator.log";
 //==============================================================================
 
 
-char const * const GRAPH_FILENAME   = "Base.dot";
-char const * const DEFAULT_BASENAME = "Base.dat";
+char const * const GRAPH_FILENAME      = "Base.dot";
+char const * const GRAPH_JSON_FILENAME = "Base.json";
+char const * const DEFAULT_BASENAME    = "Base.dat";
 const size_t MAX_STR_LEN = 128;
+const size_t MAX_MATCHES = 5;
+const size_t MAX_TYPOS   = 2;
+const size_t MAX_FOUND_FEATURES = 16;
+const int    MAX_GRAPH_DEPTH    = 1 << 16;
+const size_t MAX_RECORD_FEATURES = 64;
+const size_t RECORD_SLOTS        = 2 * MAX_RECORD_FEATURES;
 
 const char FEAT_SIGN = '?';
 const char CHAR_SIGN = '\'';
 
+struct RecordFeature
+{
+    char* data = nullptr;
+    bool  ans  = false;
+    bool  used = false;
+};
+
 class Akinator
 {
 private:
@@ -113,10 +142,21 @@ private:
     int state_;
     char lang_      = 0; // 0 - eng, 1 - rus
     char* filename_ = (char*)DEFAULT_BASENAME;
+    char* statname_ = nullptr;
 
     Tree<char*> tree_;
     Stack<char*> path2badnode_;
 
+    NameIndex    names_;
+    FeatureIndex features_;
+    ResultCache  results_;
+
+    size_t mounts_ = 0;
+
+    char*  render_     = nullptr;
+    size_t render_len_ = 0;
+    size_t render_cap_ = 0;
+
 public:
 
 //------------------------------------------------------------------------------
@@ -187,6 +227,157 @@ private:
 
     int CharCmp();
 
+//------------------------------------------------------------------------------
+/*! @brief   Finding characters by a word from features.
+ *
+ *  @return  error code
+ */
+
+    int FeatureFind();
+
+//------------------------------------------------------------------------------
+/*! @brief   Import characters with feature answers from the file.
+ *
+ *  @note    Every line of the file is a record like
+ *           'character' +?feature? -?feature? ...
+ *           where + and - are yes and no answers. All records are merged
+ *           into the tree in one pass and the base is written once.
+ *
+ *  @return  error code
+ */
+
+    int Import();
+
+//------------------------------------------------------------------------------
+/*! @brief   Parse one import record and merge it into the tree.
+ *
+ *  @param   record      Record line, it is split in place
+ *
+ *  @return  error code
+ */
+
+    int importRecord (char* record);
+
+//------------------------------------------------------------------------------
+/*! @brief   Merge another base into the tree.
+ *
+ *  @note    Path of every character of the other base is replayed as an
+ *           import record, characters already present are checked for
+ *           conflicting answers. The base is written once.
+ *
+ *  @return  error code
+ */
+
+    int Merge();
+
+//------------------------------------------------------------------------------
+/*! @brief   Merge character with feature answers into the tree.
+ *
+ *  @note    Record is refused as unresolved if a feature met on the way has
+ *           no answer in it. Reached leaf is branched by the first feature of
+ *           the record not met on the way.
+ *
+ *  @param   name        Character
+ *  @param   feats       Feature answers
+ *  @param   num         Number of feature answers
+ *
+ *  @return  error code
+ */
+
+    int mergeRecord (char* name, RecordFeature* feats, size_t num);
+
+//------------------------------------------------------------------------------
+/*! @brief   Scan name of an existing non-empty file.
+ *
+ *  @param   filename    Buffer of MAX_STR_LEN for the name
+ *
+ *  @return  true if the file can be read, else false
+ */
+
+    bool scanFilename (char* filename);
+
+//------------------------------------------------------------------------------
+/*! @brief   Export the subtree of a feature to its own base file and optionally
+ *           mount the file in place of the subtree.
+ *
+ *  @return  error code
+ */
+
+    int Export();
+
+//------------------------------------------------------------------------------
+/*! @brief   Write the base to a block compressed file.
+ *
+ *  @note    The file is loaded like a plain base file, so it can be passed
+ *           to the program instead of the base.
+ *
+ *  @return  error code
+ */
+
+    int Pack();
+
+//------------------------------------------------------------------------------
+/*! @brief   Print the latencies of the operations and the memory of the subsystems
+ *           and write all metrics to METRICS_FILENAME in the Prometheus text format.
+ *
+ *  @return  error code
+ */
+
+    int Report();
+
+//------------------------------------------------------------------------------
+/*! @brief   Find feature node by its text.
+ *
+ *  @param   feature     Feature with the signs
+ *
+ *  @return  feature node if found, else nullptr
+ */
+
+    Node<char*>* findFeature (const char* feature);
+
+//------------------------------------------------------------------------------
+/*! @brief   Load the shard of the mount point and add it to the indexes.
+ *
+ *  @param   node_cur    Mount point
+ *
+ *  @return  error code
+ */
+
+    int fetchShard (Node<char*>* node_cur);
+
+//------------------------------------------------------------------------------
+/*! @brief   Load shards of all mount points and rebuild the indexes.
+ *
+ *  @return  error code
+ */
+
+    int fetchAll ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Load the next unloaded page on the way to the label.
+ *
+ *  @param   label       Name or feature with the signs
+ *  @param   match       Comparator of a base line with the label
+ *
+ *  @return  true if a page is loaded, else false
+ */
+
+    bool fetchLabel (const char* label, bool (*match)(const char* line, const char* label));
+
+//------------------------------------------------------------------------------
+/*! @brief   Unload pages over the limit after the whole base was loaded.
+ */
+
+    void evictPages ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Print characters of the subtree to console.
+ *
+ *  @param   node_cur    Root of the subtree
+ */
+
+    void printLeaves (Node<char*>* node_cur);
+
 //------------------------------------------------------------------------------
 /*! @brief   Get a number from stdin.
  * 
@@ -217,15 +408,30 @@ private:
     char* scanChar (char c);
 
 //------------------------------------------------------------------------------
-/*! @brief   Print feature to console.
+/*! @brief   Get character name from stdin and find it in the base, suggest
+ *           similar names if there is no exact match.
+ *
+ *  @return  character node if found, else nullptr
+ */
+
+    Node<char*>* scanCharNode ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Render feature to the output buffer.
  *
  *  @param   path        Path to the element
  *  @param   item        Path item number
+ */
+
+    inline void printFeature (const Path& path, size_t item);
+
+//------------------------------------------------------------------------------
+/*! @brief   Append formatted text to the output buffer.
  *
- *  @return  1 if found, 0 if not
+ *  @param   format      Format string as in printf
  */
 
-    inline void printFeature (const Stack<size_t>& path, size_t item);
+    void Render (const char* format, ...);
 
 //------------------------------------------------------------------------------
 /*! @brief   Add new answer to the tree.
@@ -238,30 +444,105 @@ private:
     int addAns (Node<char*>* node_cur);
 
 //------------------------------------------------------------------------------
-/*! @brief   Check base for errors.
- * 
+/*! @brief   Write the base and its statistics to the files.
+ */
+
+    void saveBase ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Make statistics file name from the base file name and read it.
+ */
+
+    void loadStats ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Build the character name and feature indexes from the tree.
+ */
+
+    void buildIndex ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Recursive add characters and features of the subtree to the indexes.
+ *
  *  @param   node_cur    Current node
+ */
+
+    void indexNode (Node<char*>* node_cur);
+
+//------------------------------------------------------------------------------
+/*! @brief   Check links of the tree and syntax of its labels in one pass.
+ *
+ *  @note    Error is kept in the state, path to the bad node is kept in
+ *           path2badnode_, errors of the links are AKN_INCORRECT_INPUT_SYNTAX_BASE
+ *           and their explanation is in the tree.
+ *
+ *  @param   tree        Tree of the base
  *
  *  @return  error code
  */
 
-    int checkBase (Node<char*>* node_cur);
+    int checkBase (Tree<char*>& tree);
 
 //------------------------------------------------------------------------------
-/*! @brief   Print the contents of the tree like a graphviz dot file.
+/*! @brief   Check that the label of the node fits the number of its children.
  *
- *  @param   graphname   Name of the graph file
+ *  @param   node_cur    Node
+ *
+ *  @return  error code
+ */
+
+    static int checkNode (Node<char*>* node_cur);
+
+//------------------------------------------------------------------------------
+/*! @brief   Compare a base line with the name as the name index does.
+ *
+ *  @param   line        Base line
+ *  @param   name        Name with the signs
+ *
+ *  @return  true if the line is the name in any case, else false
  */
 
-    void printGraphBase (const char* graphname = GRAPH_FILENAME);
+    static bool matchName (const char* line, const char* name);
 
 //------------------------------------------------------------------------------
-/*! @brief   Recursive print the contents of the tree like a graphviz dot file.
+/*! @brief   Compare a base line with the feature exactly.
  *
- *  @param   graph       Dump graphviz dot file
+ *  @param   line        Base line
+ *  @param   feature     Feature with the signs
+ *
+ *  @return  true if the line is the feature, else false
+ */
+
+    static bool matchFeature (const char* line, const char* feature);
+
+//------------------------------------------------------------------------------
+/*! @brief   Find slot of the feature in the hash table of record features.
+ *
+ *  @param   feature     Feature
+ *  @param   feats       Feature answers
+ *  @param   slots       Indices of feature answers, -1 in free slots
+ *
+ *  @return  slot of the feature, else free slot for it
+ */
+
+    static size_t recordSlot (const char* feature, const RecordFeature* feats, SmallStack<int, RECORD_SLOTS>& slots);
+
+//------------------------------------------------------------------------------
+/*! @brief   Write the base or its subtree as a graphviz or JSON graph, a picture
+ *           is drawn only for graphviz.
+ *
+ *  @return  error code
+ */
+
+    int printGraphBase ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Draw the graphviz dot file to a picture and open it.
+ *
+ *  @param   graphname   Name of the graph file
  */
 
-    void printGraphNode (FILE* graph, Node<char*>* node_cur);
+    void showGraph (const char* graphname);
 
 //------------------------------------------------------------------------------
 /*! @brief   Prints an error wih description to the console and to the log file.
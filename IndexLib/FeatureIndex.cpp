@@ -0,0 +1,228 @@
+/*------------------------------------------------------------------------------
+    * File:        FeatureIndex.cpp                                            *
+    * Description: Functions for the feature index.                           *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#include "FeatureIndex.h"
+
+//------------------------------------------------------------------------------
+
+static int ComparePtr (const void* p1, const void* p2)
+{
+    assert(p1 != nullptr);
+    assert(p2 != nullptr);
+
+    size_t ptr1 = (size_t)*(void* const*)p1;
+    size_t ptr2 = (size_t)*(void* const*)p2;
+
+    return (ptr1 > ptr2) - (ptr1 < ptr2);
+}
+
+//------------------------------------------------------------------------------
+
+FeatureIndex::FeatureIndex () :
+    state_    (IDX_OK),
+    num_      (0),
+    capacity_ (DEFAULT_INDEX_CAPACITY)
+{
+    lists_ = new Postings* [capacity_];
+}
+
+//------------------------------------------------------------------------------
+
+FeatureIndex::~FeatureIndex ()
+{
+    IDX_ASSERTOK((state_ == IDX_DESTRUCTED), IDX_DESTRUCTED);
+
+    Clean();
+
+    delete [] lists_;
+    lists_ = nullptr;
+
+    capacity_ = 0;
+
+    state_ = IDX_DESTRUCTED;
+}
+
+//------------------------------------------------------------------------------
+
+int FeatureIndex::Insert (const char* text, size_t len, void* data)
+{
+    IDX_ASSERTOK((text == nullptr), IDX_NULL_INPUT_NAME, IDX_NULL_INPUT_NAME);
+    IDX_ASSERTOK((data == nullptr), IDX_NULL_INPUT_DATA, IDX_NULL_INPUT_DATA);
+
+    const char* word = text;
+
+    while (len > 0)
+    {
+        unsigned int symb = 0;
+        size_t shift = GetSymb(text, len, &symb);
+
+        if ((symb < 0x80) && (not isalnum(symb)))
+        {
+            if (word != text)
+            {
+                int err = addWord(word, text - word, data);
+                if (err) return err;
+            }
+
+            word = text + shift;
+        }
+
+        text += shift;
+        len  -= shift;
+    }
+
+    if (word != text) return addWord(word, text - word, data);
+
+    return IDX_OK;
+}
+
+//------------------------------------------------------------------------------
+
+size_t FeatureIndex::Find (const char* word, size_t len, bool prefix, void** data, size_t max_num)
+{
+    IDX_ASSERTOK((word == nullptr), IDX_NULL_INPUT_NAME, 0);
+    IDX_ASSERTOK((data == nullptr), IDX_NULL_INPUT_DATA, 0);
+
+    if (not prefix)
+    {
+        Postings* list = (Postings*)words_.Find(word, len);
+        if (list == nullptr) return 0;
+
+        for (size_t i = 0; (i < list->num_) && (i < max_num); ++i)
+            data[i] = list->data_[i];
+
+        return list->num_;
+    }
+
+    // a full buffer may have lost forms, so it is doubled and searched again
+    size_t     forms_max = 0;
+    NameMatch* matches   = nullptr;
+    size_t     forms     = 0;
+
+    do
+    {
+        delete [] matches;
+        forms_max = (forms_max == 0) ? DEFAULT_WORD_FORMS : forms_max * 2;
+
+        matches = new (std::nothrow) NameMatch [forms_max];
+        if (matches == nullptr) return 0;
+
+        forms = words_.Search(word, len, 0, matches, forms_max);
+    }
+    while (forms == forms_max);
+
+    size_t total = 0;
+    for (size_t i = 0; i < forms; ++i)
+        total += ((Postings*)matches[i].data)->num_;
+
+    void** all = (total == 0) ? nullptr : new (std::nothrow) void* [total];
+    if (all == nullptr)
+    {
+        delete [] matches;
+        return 0;
+    }
+
+    size_t num = 0;
+
+    for (size_t i = 0; i < forms; ++i)
+    {
+        Postings* list = (Postings*)matches[i].data;
+        for (size_t j = 0; j < list->num_; ++j)
+            all[num++] = list->data_[j];
+    }
+
+    qsort(all, total, sizeof(void*), ComparePtr);
+
+    num = 0;
+    for (size_t i = 0; i < total; ++i)
+        if ((i == 0) || (all[i] != all[i - 1]))
+        {
+            if (num < max_num) data[num] = all[i];
+            ++num;
+        }
+
+    delete [] all;
+    delete [] matches;
+
+    return num;
+}
+
+//------------------------------------------------------------------------------
+
+void FeatureIndex::Clean ()
+{
+    IDX_ASSERTOK((state_ == IDX_DESTRUCTED), IDX_DESTRUCTED);
+
+    for (size_t i = 0; i < num_; ++i)
+    {
+        delete [] lists_[i]->data_;
+        delete lists_[i];
+    }
+
+    num_ = 0;
+
+    words_.Clean();
+}
+
+//------------------------------------------------------------------------------
+
+int FeatureIndex::addWord (const char* word, size_t len, void* data)
+{
+    Postings* list = (Postings*)words_.Find(word, len);
+
+    if (list == nullptr)
+    {
+        if (num_ == capacity_)
+        {
+            Postings** temp = new (std::nothrow) Postings* [capacity_ * 2];
+            if (temp == nullptr) return IDX_NO_MEMORY;
+
+            memcpy(temp, lists_, num_ * sizeof(Postings*));
+            delete [] lists_;
+
+            lists_     = temp;
+            capacity_ *= 2;
+        }
+
+        list = new Postings;
+        list->capacity_ = 1;
+        list->data_     = new void* [list->capacity_];
+
+        int err = words_.Insert(word, len, list);
+        if (err)
+        {
+            delete [] list->data_;
+            delete list;
+            return err;
+        }
+
+        lists_[num_++] = list;
+    }
+
+    if ((list->num_ != 0) && (list->data_[list->num_ - 1] == data)) return IDX_OK;
+
+    if (list->num_ == list->capacity_)
+    {
+        void** temp = new (std::nothrow) void* [list->capacity_ * 2];
+        if (temp == nullptr) return IDX_NO_MEMORY;
+
+        memcpy(temp, list->data_, list->num_ * sizeof(void*));
+        delete [] list->data_;
+
+        list->data_      = temp;
+        list->capacity_ *= 2;
+    }
+
+    list->data_[list->num_++] = data;
+
+    return IDX_OK;
+}
+
+//------------------------------------------------------------------------------
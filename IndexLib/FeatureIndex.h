@@ -0,0 +1,124 @@
+/*------------------------------------------------------------------------------
+    * File:        FeatureIndex.h                                              *
+    * Description: Declaration of functions and data types used for the       *
+                   inverted index over words of feature questions.             *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#ifndef FEATUREINDEX_H_INCLUDED
+#define FEATUREINDEX_H_INCLUDED
+
+#define _CRT_SECURE_NO_WARNINGS
+
+
+#include "IndexConfig.h"
+#include "NameIndex.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <new>
+
+
+const size_t DEFAULT_WORD_FORMS = 64; // the word forms buffer grows until all forms fit
+
+struct Postings
+{
+    void** data_     = nullptr;
+    size_t num_      = 0;
+    size_t capacity_ = 0;
+};
+
+class FeatureIndex
+{
+    int state_;
+
+    NameIndex words_;
+
+    Postings** lists_    = nullptr;
+    size_t     num_      = 0;
+    size_t     capacity_ = 0;
+
+public:
+
+//------------------------------------------------------------------------------
+/*! @brief   Feature index constructor.
+ */
+
+    FeatureIndex ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Feature index copy constructor (deleted).
+ *
+ *  @param   obj         Source index
+ */
+
+    FeatureIndex (const FeatureIndex& obj);
+
+    FeatureIndex& operator = (const FeatureIndex& obj); // deleted
+
+//------------------------------------------------------------------------------
+/*! @brief   Feature index destructor.
+ */
+
+   ~FeatureIndex ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Add every word of the feature text to the index.
+ *
+ *  @param   text        Feature text
+ *  @param   len         Length of the text in bytes
+ *  @param   data        Data bound to the feature
+ *
+ *  @return  error code
+ */
+
+    int Insert (const char* text, size_t len, void* data);
+
+//------------------------------------------------------------------------------
+/*! @brief   Find features containing the word.
+ *
+ *  @param   word        Word (case insensitive)
+ *  @param   len         Length of the word in bytes
+ *  @param   prefix      Also find features with words starting with the word
+ *  @param   data        Array of found data, each data is found once
+ *  @param   max_num     Size of the data array
+ *
+ *  @return  number of found data, may be bigger than max_num
+ */
+
+    size_t Find (const char* word, size_t len, bool prefix, void** data, size_t max_num);
+
+//------------------------------------------------------------------------------
+/*! @brief   Remove all features from the index.
+ */
+
+    void Clean ();
+
+/*------------------------------------------------------------------------------
+                   Private functions                                           *
+*///----------------------------------------------------------------------------
+
+private:
+
+//------------------------------------------------------------------------------
+/*! @brief   Add data to the postings list of the word.
+ *
+ *  @param   word        Word
+ *  @param   len         Length of the word in bytes
+ *  @param   data        Data bound to the feature
+ *
+ *  @return  error code
+ */
+
+    int addWord (const char* word, size_t len, void* data);
+
+//------------------------------------------------------------------------------
+};
+
+#endif // FEATUREINDEX_H_INCLUDED
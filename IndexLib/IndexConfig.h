@@ -0,0 +1,101 @@
+/*------------------------------------------------------------------------------
+    * File:        IndexConfig.h                                               *
+    * Description: Index congigurations which define different index          *
+                   constants and errors                                        *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#ifndef INDEX_CONFIG_H_INCLUDED
+#define INDEX_CONFIG_H_INCLUDED
+
+
+#include <stdlib.h>
+#include <time.h>
+
+
+#if defined (__GNUC__) || defined (__clang__) || defined (__clang_major__)
+    #define __FUNC_NAME__   __PRETTY_FUNCTION__
+    #define PRINT_PTR       "%p"
+
+#elif defined (_MSC_VER)
+    #define __FUNC_NAME__   __FUNCSIG__
+    #define PRINT_PTR       "0x%p"
+
+#else
+    #define __FUNC_NAME__   __FUNCTION__
+    #define PRINT_PTR       "%p"
+
+#endif
+
+
+char const * const INDEX_LOGNAME = "index.log";
+
+const size_t DEFAULT_INDEX_CAPACITY = 64;
+const size_t MAX_NAME_SYMBS         = 256;
+const size_t DEFAULT_CACHE_CAPACITY = 64;
+
+
+enum IndexErrors
+{
+    IDX_NOT_OK = -1                                                    ,
+    IDX_OK = 0                                                         ,
+    IDX_NO_MEMORY                                                      ,
+
+    IDX_DESTRUCTED                                                     ,
+    IDX_NULL_INPUT_DATA                                                ,
+    IDX_NULL_INPUT_NAME                                                ,
+    IDX_TOO_LONG_NAME                                                  ,
+    IDX_NULL_INPUT_TEXT                                                ,
+};
+
+char const * const idx_errstr[] =
+{
+    "ERROR"                                                            ,
+    "OK"                                                               ,
+    "Failed to allocate memory"                                        ,
+
+    "Index has already destructed"                                     ,
+    "The input value of the index data turned out to be zero"          ,
+    "The input value of the index name turned out to be zero"          ,
+    "Name is too long for the index"                                   ,
+    "The input value of the cached text turned out to be zero"         ,
+};
+
+#define IDX_ASSERTOK(cond, err, ...) if (cond)                                                               \
+                                     {                                                                       \
+                                       IdxPrintError(INDEX_LOGNAME, __FILE__, __LINE__, __FUNC_NAME__, err); \
+                                       return __VA_ARGS__;                                                   \
+                                     } //
+
+
+//------------------------------------------------------------------------------
+/*! @brief   Prints an error wih description to the console and to the log file.
+ *
+ *  @param   logname     Name of the log file
+ *  @param   file        Name of the program file
+ *  @param   line        Number of line with an error
+ *  @param   function    Name of the function with an error
+ *  @param   err         Error code
+ */
+
+void IdxPrintError (const char* logname, const char* file, int line, const char* function, int err);
+
+//------------------------------------------------------------------------------
+/*! @brief   Decode one UTF-8 symbol and convert it to lowercase.
+ *
+ *  @param   str         C string
+ *  @param   len         Number of bytes left in the string
+ *  @param   symb        Decoded symbol
+ *
+ *  @return  number of bytes of the symbol
+ */
+
+size_t GetSymb (const char* str, size_t len, unsigned int* symb);
+
+//------------------------------------------------------------------------------
+
+#endif // INDEX_CONFIG_H_INCLUDED
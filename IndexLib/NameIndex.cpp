@@ -0,0 +1,279 @@
+/*------------------------------------------------------------------------------
+    * File:        NameIndex.cpp                                               *
+    * Description: Functions for the name index.                              *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#include "NameIndex.h"
+
+//------------------------------------------------------------------------------
+
+NameIndex::NameIndex () :
+    state_    (IDX_OK),
+    num_      (1),
+    capacity_ (DEFAULT_INDEX_CAPACITY)
+{
+    nodes_ = new TrieNode [capacity_];
+}
+
+//------------------------------------------------------------------------------
+
+NameIndex::~NameIndex ()
+{
+    IDX_ASSERTOK((state_ == IDX_DESTRUCTED), IDX_DESTRUCTED);
+
+    delete [] nodes_;
+    nodes_ = nullptr;
+
+    num_      = 0;
+    capacity_ = 0;
+
+    state_ = IDX_DESTRUCTED;
+}
+
+//------------------------------------------------------------------------------
+
+int NameIndex::Insert (const char* name, size_t len, void* data)
+{
+    IDX_ASSERTOK((name == nullptr), IDX_NULL_INPUT_NAME, IDX_NULL_INPUT_NAME);
+    IDX_ASSERTOK((data == nullptr), IDX_NULL_INPUT_DATA, IDX_NULL_INPUT_DATA);
+
+    int    node  = 0;
+    size_t symbs = 0;
+
+    while (len > 0)
+    {
+        unsigned int symb = 0;
+        size_t shift = GetSymb(name, len, &symb);
+
+        name += shift;
+        len  -= shift;
+
+        if (++symbs > MAX_NAME_SYMBS) return IDX_TOO_LONG_NAME;
+
+        node = getChild(node, symb, true);
+        if (node == -1) return IDX_NO_MEMORY;
+    }
+
+    nodes_[node].data = data;
+
+    if (symbs > max_len_) max_len_ = symbs;
+
+    return IDX_OK;
+}
+
+//------------------------------------------------------------------------------
+
+void* NameIndex::Find (const char* name, size_t len)
+{
+    IDX_ASSERTOK((name == nullptr), IDX_NULL_INPUT_NAME, nullptr);
+
+    int node = 0;
+
+    while ((len > 0) && (node != -1))
+    {
+        unsigned int symb = 0;
+        size_t shift = GetSymb(name, len, &symb);
+
+        name += shift;
+        len  -= shift;
+
+        node = getChild(node, symb, false);
+    }
+
+    return (node == -1) ? nullptr : nodes_[node].data;
+}
+
+//------------------------------------------------------------------------------
+
+size_t NameIndex::Search (const char* query, size_t len, size_t max_dist, NameMatch* matches, size_t max_num)
+{
+    IDX_ASSERTOK((query   == nullptr), IDX_NULL_INPUT_NAME, 0);
+    IDX_ASSERTOK((matches == nullptr), IDX_NULL_INPUT_DATA, 0);
+
+    if (max_num == 0) return 0;
+
+    unsigned int symbs[MAX_NAME_SYMBS] = {};
+    size_t qlen = 0;
+
+    while ((len > 0) && (qlen < MAX_NAME_SYMBS))
+    {
+        size_t shift = GetSymb(query, len, symbs + qlen++);
+
+        query += shift;
+        len   -= shift;
+    }
+
+    size_t* rows = new size_t [(max_len_ + 1) * (qlen + 1)];
+    for (size_t j = 0; j <= qlen; ++j) rows[j] = j;
+
+    size_t num = 0;
+    searchNode(0, 0, symbs, qlen, rows, qlen, max_dist, matches, num, max_num);
+
+    delete [] rows;
+
+    return num;
+}
+
+//------------------------------------------------------------------------------
+
+void NameIndex::Clean ()
+{
+    IDX_ASSERTOK((state_ == IDX_DESTRUCTED), IDX_DESTRUCTED);
+
+    for (size_t i = 0; i < num_; ++i)
+        nodes_[i] = {};
+
+    num_     = 1;
+    max_len_ = 0;
+}
+
+//------------------------------------------------------------------------------
+
+int NameIndex::getChild (int node, unsigned int symb, bool create)
+{
+    for (int child = nodes_[node].child; child != -1; child = nodes_[child].next)
+        if (nodes_[child].symb == symb) return child;
+
+    if (not create) return -1;
+
+    if ((num_ == capacity_) && Expand()) return -1;
+
+    int child = num_++;
+
+    nodes_[child].symb  = symb;
+    nodes_[child].next  = nodes_[node].child;
+    nodes_[node].child  = child;
+
+    return child;
+}
+
+//------------------------------------------------------------------------------
+
+void NameIndex::searchNode (int node, size_t depth, const unsigned int* query, size_t qlen, size_t* rows, size_t best,
+                            size_t max_dist, NameMatch* matches, size_t& num, size_t max_num)
+{
+    const size_t* prev = rows + depth * (qlen + 1);
+    size_t*       row  = rows + (depth + 1) * (qlen + 1);
+
+    for (int child = nodes_[node].child; child != -1; child = nodes_[child].next)
+    {
+        row[0] = depth + 1;
+        size_t row_min = row[0];
+
+        for (size_t j = 1; j <= qlen; ++j)
+        {
+            size_t cost = (query[j - 1] == nodes_[child].symb) ? 0 : 1;
+
+            row[j] = prev[j - 1] + cost;
+            if (prev[j] + 1 < row[j]) row[j] = prev[j] + 1;
+            if (row[j - 1] + 1 < row[j]) row[j] = row[j - 1] + 1;
+
+            if (row[j] < row_min) row_min = row[j];
+        }
+
+        size_t child_best = (row[qlen] < best) ? row[qlen] : best;
+
+        // row minimum never decreases deeper in the trie, so nothing below can do better
+        size_t bound = (row_min < child_best) ? row_min : child_best;
+        if (bound > max_dist) continue;
+        if ((num == max_num) && (bound > matches[num - 1].dist)) continue;
+
+        if ((nodes_[child].data != nullptr) && (child_best <= max_dist))
+        {
+            size_t pos = num;
+            while ((pos > 0) && ((matches[pos - 1].dist > child_best) ||
+                                 ((matches[pos - 1].dist == child_best) && (matches[pos - 1].len > depth + 1))))
+                --pos;
+
+            if (pos < max_num)
+            {
+                if (num < max_num) ++num;
+
+                for (size_t i = num - 1; i > pos; --i)
+                    matches[i] = matches[i - 1];
+
+                matches[pos].data = nodes_[child].data;
+                matches[pos].dist = child_best;
+                matches[pos].len  = depth + 1;
+            }
+        }
+
+        searchNode(child, depth + 1, query, qlen, rows, child_best, max_dist, matches, num, max_num);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+int NameIndex::Expand ()
+{
+    TrieNode* temp = new (std::nothrow) TrieNode [capacity_ * 2];
+    if (temp == nullptr) return IDX_NO_MEMORY;
+
+    for (size_t i = 0; i < num_; ++i)
+        temp[i] = nodes_[i];
+
+    delete [] nodes_;
+
+    nodes_     = temp;
+    capacity_ *= 2;
+
+    return IDX_OK;
+}
+
+//------------------------------------------------------------------------------
+
+size_t GetSymb (const char* str, size_t len, unsigned int* symb)
+{
+    assert(str  != nullptr);
+    assert(symb != nullptr);
+    assert(len);
+
+    const unsigned char* s = (const unsigned char*)str;
+
+    size_t size = 1;
+    *symb = s[0];
+
+    if      (((s[0] & 0xE0) == 0xC0) && (len >= 2)) { size = 2; *symb = s[0] & 0x1F; }
+    else if (((s[0] & 0xF0) == 0xE0) && (len >= 3)) { size = 3; *symb = s[0] & 0x0F; }
+    else if (((s[0] & 0xF8) == 0xF0) && (len >= 4)) { size = 4; *symb = s[0] & 0x07; }
+
+    for (size_t i = 1; i < size; ++i)
+    {
+        if ((s[i] & 0xC0) != 0x80)
+        {
+            *symb = s[0];
+            return 1;
+        }
+
+        *symb = (*symb << 6) | (s[i] & 0x3F);
+    }
+
+    if      (('A' <= *symb) && (*symb <= 'Z'))       *symb += 'a' - 'A';
+    else if ((0x0410 <= *symb) && (*symb <= 0x042F)) *symb += 0x20;     // А-Я
+    else if ((0x0400 <= *symb) && (*symb <= 0x040F)) *symb += 0x50;     // Ѐ-Џ
+
+    if (*symb == 0x0451) *symb = 0x0435;                                // ё as е
+
+    return size;
+}
+
+//------------------------------------------------------------------------------
+
+void IdxPrintError (const char* logname, const char* file, int line, const char* function, int err)
+{
+    assert(function != nullptr);
+    assert(logname  != nullptr);
+    assert(file     != nullptr);
+
+    LogError(logname, "index", file, line, function, err, idx_errstr[err + 1]);
+
+    printf (     "ERROR: file %s  line %d  function %s\n",   file, line, function);
+    printf (     "%s\n\n", idx_errstr[err + 1]);
+}
+
+//------------------------------------------------------------------------------
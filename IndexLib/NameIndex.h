@@ -0,0 +1,170 @@
+/*------------------------------------------------------------------------------
+    * File:        NameIndex.h                                                 *
+    * Description: Declaration of functions and data types used for the name  *
+                   index with prefix and fuzzy search.                         *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#ifndef NAMEINDEX_H_INCLUDED
+#define NAMEINDEX_H_INCLUDED
+
+#define _CRT_SECURE_NO_WARNINGS
+
+
+#include "IndexConfig.h"
+#include "../LogLib/Log.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <new>
+
+
+struct TrieNode
+{
+    unsigned int symb  = 0;
+    int          child = -1;
+    int          next  = -1;
+    void*        data  = nullptr;
+};
+
+struct NameMatch
+{
+    void*  data = nullptr;
+    size_t dist = 0;
+    size_t len  = 0;
+};
+
+class NameIndex
+{
+    int state_;
+
+    TrieNode* nodes_    = nullptr;
+    size_t    num_      = 0;
+    size_t    capacity_ = 0;
+
+    size_t max_len_ = 0;
+
+public:
+
+//------------------------------------------------------------------------------
+/*! @brief   Name index constructor.
+ */
+
+    NameIndex ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Name index copy constructor (deleted).
+ *
+ *  @param   obj         Source index
+ */
+
+    NameIndex (const NameIndex& obj);
+
+    NameIndex& operator = (const NameIndex& obj); // deleted
+
+//------------------------------------------------------------------------------
+/*! @brief   Name index destructor.
+ */
+
+   ~NameIndex ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Add name to the index.
+ *
+ *  @param   name        Name (case insensitive)
+ *  @param   len         Length of the name in bytes
+ *  @param   data        Data bound to the name
+ *
+ *  @return  error code
+ */
+
+    int Insert (const char* name, size_t len, void* data);
+
+//------------------------------------------------------------------------------
+/*! @brief   Find data by the exact name.
+ *
+ *  @param   name        Name (case insensitive)
+ *  @param   len         Length of the name in bytes
+ *
+ *  @return  data bound to the name if found, else nullptr
+ */
+
+    void* Find (const char* name, size_t len);
+
+//------------------------------------------------------------------------------
+/*! @brief   Find names starting with the query within the edit distance.
+ *
+ *  @note    Distance of the name is the least Levenshtein distance between
+ *           the query and any prefix of the name, so exact prefixes have
+ *           distance 0. Matches are sorted by distance, then by length.
+ *
+ *  @param   query       Query (case insensitive)
+ *  @param   len         Length of the query in bytes
+ *  @param   max_dist    Maximum edit distance
+ *  @param   matches     Array of found matches
+ *  @param   max_num     Size of the matches array
+ *
+ *  @return  number of found matches
+ */
+
+    size_t Search (const char* query, size_t len, size_t max_dist, NameMatch* matches, size_t max_num);
+
+//------------------------------------------------------------------------------
+/*! @brief   Remove all names from the index.
+ */
+
+    void Clean ();
+
+/*------------------------------------------------------------------------------
+                   Private functions                                           *
+*///----------------------------------------------------------------------------
+
+private:
+
+//------------------------------------------------------------------------------
+/*! @brief   Get child of the trie node with the symbol.
+ *
+ *  @param   node        Trie node
+ *  @param   symb        Symbol
+ *  @param   create      Create child if it is absent
+ *
+ *  @return  child index if found or created, else -1
+ */
+
+    int getChild (int node, unsigned int symb, bool create);
+
+//------------------------------------------------------------------------------
+/*! @brief   Recursive search in the trie with computing rows of Levenshtein matrix.
+ *
+ *  @param   node        Current trie node
+ *  @param   depth       Depth of the node
+ *  @param   query       Query symbols
+ *  @param   qlen        Number of query symbols
+ *  @param   rows        Levenshtein matrix rows for depths from 0
+ *  @param   best        Least distance to the query on the way to the node
+ *  @param   max_dist    Maximum edit distance
+ *  @param   matches     Array of found matches
+ *  @param   num         Number of found matches
+ *  @param   max_num     Size of the matches array
+ */
+
+    void searchNode (int node, size_t depth, const unsigned int* query, size_t qlen, size_t* rows, size_t best,
+                     size_t max_dist, NameMatch* matches, size_t& num, size_t max_num);
+
+//------------------------------------------------------------------------------
+/*! @brief   Increase the trie by 2 times.
+ *
+ *  @return  error code
+ */
+
+    int Expand ();
+
+//------------------------------------------------------------------------------
+};
+
+#endif // NAMEINDEX_H_INCLUDED
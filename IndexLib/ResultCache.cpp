@@ -0,0 +1,210 @@
+/*------------------------------------------------------------------------------
+    * File:        ResultCache.cpp                                             *
+    * Description: Functions for the LRU cache of rendered query results.      *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#include "ResultCache.h"
+
+//------------------------------------------------------------------------------
+
+ResultCache::ResultCache (size_t capacity) :
+    state_    (IDX_OK),
+    capacity_ ((capacity == 0) ? 1 : capacity)
+{
+    entries_ = new CacheEntry [capacity_];
+
+    buckets_num_ = 1;
+    while (buckets_num_ < capacity_ * 2) buckets_num_ *= 2;
+
+    buckets_ = new int [buckets_num_];
+    for (size_t i = 0; i < buckets_num_; ++i)
+        buckets_[i] = -1;
+}
+
+//------------------------------------------------------------------------------
+
+ResultCache::~ResultCache ()
+{
+    IDX_ASSERTOK((state_ == IDX_DESTRUCTED), IDX_DESTRUCTED);
+
+    for (size_t i = 0; i < num_; ++i)
+        delete [] entries_[i].text;
+
+    delete [] entries_;
+    delete [] buckets_;
+    entries_ = nullptr;
+    buckets_ = nullptr;
+
+    num_      = 0;
+    capacity_ = 0;
+
+    state_ = IDX_DESTRUCTED;
+}
+
+//------------------------------------------------------------------------------
+
+const char* ResultCache::Find (const void* first, const void* second, int lang)
+{
+    IDX_ASSERTOK((first == nullptr), IDX_NULL_INPUT_DATA, nullptr);
+
+    int entry = buckets_[getBucket(first, second, lang)];
+
+    for (; entry != -1; entry = entries_[entry].hnext)
+        if ((entries_[entry].first == first) && (entries_[entry].second == second) && (entries_[entry].lang == lang))
+        {
+            Touch(entry);
+            return entries_[entry].text;
+        }
+
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+
+int ResultCache::Insert (const void* first, const void* second, int lang, const char* text)
+{
+    IDX_ASSERTOK((first == nullptr), IDX_NULL_INPUT_DATA, IDX_NULL_INPUT_DATA);
+    IDX_ASSERTOK((text  == nullptr), IDX_NULL_INPUT_TEXT, IDX_NULL_INPUT_TEXT);
+
+    char* copy = new (std::nothrow) char [strlen(text) + 1];
+    if (copy == nullptr) return IDX_NO_MEMORY;
+    strcpy(copy, text);
+
+    size_t bucket = getBucket(first, second, lang);
+
+    int entry = buckets_[bucket];
+    for (; entry != -1; entry = entries_[entry].hnext)
+        if ((entries_[entry].first == first) && (entries_[entry].second == second) && (entries_[entry].lang == lang))
+        {
+            delete [] entries_[entry].text;
+            entries_[entry].text = copy;
+
+            Touch(entry);
+            return IDX_OK;
+        }
+
+    if ((free_ == -1) && (num_ == capacity_))
+        Remove(tail_);
+
+    if (free_ != -1)
+    {
+        entry = free_;
+        free_ = entries_[entry].next;
+    }
+    else
+        entry = (int)num_++;
+
+    entries_[entry].first  = first;
+    entries_[entry].second = second;
+    entries_[entry].lang   = lang;
+    entries_[entry].text   = copy;
+
+    entries_[entry].hnext = buckets_[bucket];
+    buckets_[bucket]      = entry;
+
+    entries_[entry].prev = -1;
+    entries_[entry].next = head_;
+    if (head_ != -1) entries_[head_].prev = entry;
+    head_ = entry;
+    if (tail_ == -1) tail_ = entry;
+
+    return IDX_OK;
+}
+
+//------------------------------------------------------------------------------
+
+void ResultCache::Invalidate (const void* data)
+{
+    int entry = head_;
+
+    while (entry != -1)
+    {
+        int next = entries_[entry].next;
+
+        if ((entries_[entry].first == data) || (entries_[entry].second == data))
+            Remove(entry);
+
+        entry = next;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void ResultCache::Clean ()
+{
+    while (head_ != -1)
+        Remove(head_);
+}
+
+//------------------------------------------------------------------------------
+
+size_t ResultCache::getBucket (const void* first, const void* second, int lang)
+{
+    size_t hash = (size_t)first;
+    hash = hash * 31 + (size_t)second;
+    hash = hash * 31 + (size_t)lang;
+    hash ^= (hash >> 4) ^ (hash >> 12) ^ (hash >> 20);
+
+    return hash & (buckets_num_ - 1);
+}
+
+//------------------------------------------------------------------------------
+
+void ResultCache::Touch (int entry)
+{
+    if (head_ == entry) return;
+
+    CacheEntry& cur = entries_[entry];
+
+    entries_[cur.prev].next = cur.next;
+    if (cur.next != -1) entries_[cur.next].prev = cur.prev;
+    else                tail_ = cur.prev;
+
+    cur.prev = -1;
+    cur.next = head_;
+    entries_[head_].prev = entry;
+    head_ = entry;
+}
+
+//------------------------------------------------------------------------------
+
+void ResultCache::Unlink (int entry)
+{
+    CacheEntry& cur = entries_[entry];
+
+    int* link = &buckets_[getBucket(cur.first, cur.second, cur.lang)];
+    while (*link != entry) link = &entries_[*link].hnext;
+    *link = cur.hnext;
+
+    if (cur.prev != -1) entries_[cur.prev].next = cur.next;
+    else                head_ = cur.next;
+
+    if (cur.next != -1) entries_[cur.next].prev = cur.prev;
+    else                tail_ = cur.prev;
+}
+
+//------------------------------------------------------------------------------
+
+void ResultCache::Remove (int entry)
+{
+    Unlink(entry);
+
+    CacheEntry& cur = entries_[entry];
+
+    delete [] cur.text;
+    cur.text   = nullptr;
+    cur.first  = nullptr;
+    cur.second = nullptr;
+    cur.prev   = -1;
+    cur.hnext  = -1;
+
+    cur.next = free_;
+    free_    = entry;
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,163 @@
+/*------------------------------------------------------------------------------
+    * File:        ResultCache.h                                               *
+    * Description: Declaration of the LRU cache of rendered query results.     *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#ifndef RESULTCACHE_H_INCLUDED
+#define RESULTCACHE_H_INCLUDED
+
+#define _CRT_SECURE_NO_WARNINGS
+
+
+#include "IndexConfig.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <new>
+
+
+struct CacheEntry
+{
+    const void* first  = nullptr;
+    const void* second = nullptr;
+    int         lang   = 0;
+
+    char* text = nullptr;
+
+    int prev  = -1;
+    int next  = -1;
+    int hnext = -1;
+};
+
+class ResultCache
+{
+    int state_;
+
+    CacheEntry* entries_  = nullptr;
+    size_t      capacity_ = 0;
+    size_t      num_      = 0;
+
+    int*   buckets_     = nullptr;
+    size_t buckets_num_ = 0;
+
+    int head_ = -1;
+    int tail_ = -1;
+    int free_ = -1;
+
+public:
+
+//------------------------------------------------------------------------------
+/*! @brief   Result cache constructor.
+ *
+ *  @param   capacity    Maximum number of cached results
+ */
+
+    ResultCache (size_t capacity = DEFAULT_CACHE_CAPACITY);
+
+//------------------------------------------------------------------------------
+/*! @brief   Result cache copy constructor (deleted).
+ *
+ *  @param   obj         Source cache
+ */
+
+    ResultCache (const ResultCache& obj);
+
+    ResultCache& operator = (const ResultCache& obj); // deleted
+
+//------------------------------------------------------------------------------
+/*! @brief   Result cache destructor.
+ */
+
+   ~ResultCache ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Find cached result and mark it as recently used.
+ *
+ *  @param   first       First key data
+ *  @param   second      Second key data (nullptr for single keys)
+ *  @param   lang        Language of the result
+ *
+ *  @return  cached text if found, else nullptr
+ */
+
+    const char* Find (const void* first, const void* second, int lang);
+
+//------------------------------------------------------------------------------
+/*! @brief   Add result to the cache, the least recently used one is evicted if full.
+ *
+ *  @param   first       First key data
+ *  @param   second      Second key data (nullptr for single keys)
+ *  @param   lang        Language of the result
+ *  @param   text        Rendered result (copied)
+ *
+ *  @return  error code
+ */
+
+    int Insert (const void* first, const void* second, int lang, const char* text);
+
+//------------------------------------------------------------------------------
+/*! @brief   Remove all results with the data in the key.
+ *
+ *  @param   data        Key data
+ */
+
+    void Invalidate (const void* data);
+
+//------------------------------------------------------------------------------
+/*! @brief   Remove all results from the cache.
+ */
+
+    void Clean ();
+
+/*------------------------------------------------------------------------------
+                   Private functions                                           *
+*///----------------------------------------------------------------------------
+
+private:
+
+//------------------------------------------------------------------------------
+/*! @brief   Get bucket of the key.
+ *
+ *  @param   first       First key data
+ *  @param   second      Second key data
+ *  @param   lang        Language of the result
+ *
+ *  @return  bucket number
+ */
+
+    size_t getBucket (const void* first, const void* second, int lang);
+
+//------------------------------------------------------------------------------
+/*! @brief   Move entry to the head of the recently used list.
+ *
+ *  @param   entry       Entry number
+ */
+
+    void Touch (int entry);
+
+//------------------------------------------------------------------------------
+/*! @brief   Unlink entry from its bucket and from the recently used list.
+ *
+ *  @param   entry       Entry number
+ */
+
+    void Unlink (int entry);
+
+//------------------------------------------------------------------------------
+/*! @brief   Remove entry from the cache.
+ *
+ *  @param   entry       Entry number
+ */
+
+    void Remove (int entry);
+
+//------------------------------------------------------------------------------
+};
+
+#endif // RESULTCACHE_H_INCLUDED
@@ -0,0 +1,270 @@
+/*------------------------------------------------------------------------------
+    * File:        Log.cpp                                                     *
+    * Description: Functions for the asynchronous logging.                     *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#include "Log.h"
+
+//------------------------------------------------------------------------------
+
+static void localTime (time_t t, struct tm* tm)
+{
+#if defined (_MSC_VER)
+    localtime_s(tm, &t);
+#else
+    localtime_r(&t, tm);
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+Logger::Logger () :
+    state_   (LOG_OK),
+    head_    (0),
+    tail_    (0),
+    dropped_ (0),
+    level_   (LOG_DEFAULT_LEVEL),
+    running_ (true)
+{
+    ring_ = new (std::nothrow) LogSlot [LOG_RING_SIZE];
+    if (ring_ == nullptr)
+    {
+        state_ = LOG_NO_MEMORY;
+        return;
+    }
+
+    // slot is free for the record number equal to its sequence
+    for (size_t i = 0; i < LOG_RING_SIZE; ++i)
+        ring_[i].seq.store(i, std::memory_order_relaxed);
+
+    writer_ = std::thread(&Logger::Run, this);
+}
+
+//------------------------------------------------------------------------------
+
+Logger::~Logger ()
+{
+    if (state_ == LOG_DESTRUCTED) return;
+
+    if (writer_.joinable())
+    {
+        running_.store(false, std::memory_order_release);
+        writer_.join();
+    }
+
+    if (ring_ != nullptr) Drain();
+
+    for (size_t i = 0; i < LOG_MAX_FILES; ++i)
+        if (files_[i].file != nullptr)
+        {
+            fclose(files_[i].file);
+            files_[i].file = nullptr;
+            files_[i].name = nullptr;
+        }
+
+    delete [] ring_;
+    ring_ = nullptr;
+
+    state_ = LOG_DESTRUCTED;
+}
+
+//------------------------------------------------------------------------------
+
+int Logger::Write (int level, const char* logname, const char* format, va_list args)
+{
+    if (state_ != LOG_OK)    return state_;
+    if (logname == nullptr)  return LOG_NULL_INPUT_LOGNAME;
+    if (!isEnabled(level))   return LOG_LEVEL_FILTERED;
+
+    size_t   pos  = head_.load(std::memory_order_relaxed);
+    LogSlot* slot = nullptr;
+
+    for (;;)
+    {
+        slot = ring_ + (pos & (LOG_RING_SIZE - 1));
+        size_t seq = slot->seq.load(std::memory_order_acquire);
+
+        if (seq == pos)
+        {
+            if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        }
+        else if (seq < pos)
+        {
+            // writer has not freed the slot yet, the record is not waited for
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return LOG_RING_FULL;
+        }
+        else pos = head_.load(std::memory_order_relaxed);
+    }
+
+    slot->logname = logname;
+    slot->level   = level;
+    slot->time    = time(NULL);
+    vsnprintf(slot->text, LOG_RECORD_SIZE, format, args);
+
+    slot->seq.store(pos + 1, std::memory_order_release);
+
+    return LOG_OK;
+}
+
+//------------------------------------------------------------------------------
+
+void Logger::Flush ()
+{
+    if (state_ != LOG_OK) return;
+
+    size_t target = head_.load(std::memory_order_acquire);
+
+    while (running_.load(std::memory_order_acquire) && (tail_.load(std::memory_order_acquire) < target))
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+//------------------------------------------------------------------------------
+
+bool Logger::isEnabled (int level) const
+{
+    return level >= level_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+void Logger::setLevel (int level)
+{
+    level_.store(level, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+size_t Logger::getDropped () const
+{
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+void Logger::Run ()
+{
+    while (running_.load(std::memory_order_acquire))
+    {
+        if (Drain() == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(LOG_IDLE_WAIT));
+    }
+}
+
+//------------------------------------------------------------------------------
+
+size_t Logger::Drain ()
+{
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    size_t num = 0;
+
+    for (;;)
+    {
+        LogSlot* slot = ring_ + (pos & (LOG_RING_SIZE - 1));
+        if (slot->seq.load(std::memory_order_acquire) != pos + 1) break;
+
+        FILE* log = getFile(slot->logname);
+        if (log != nullptr)
+        {
+            struct tm tm = {};
+            localTime(slot->time, &tm);
+
+            fprintf(log, "time=%d-%02d-%02dT%02d:%02d:%02d level=%s %s\n",
+                    tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec,
+                    log_lvlstr[slot->level], slot->text);
+        }
+        else dropped_.fetch_add(1, std::memory_order_relaxed);
+
+        slot->seq.store(pos + LOG_RING_SIZE, std::memory_order_release);
+        ++pos;
+        ++num;
+    }
+
+    if (num == 0) return 0;
+
+    for (size_t i = 0; i < LOG_MAX_FILES; ++i)
+        if (files_[i].file != nullptr) fflush(files_[i].file);
+
+    // records are counted as written only when they reached the files
+    tail_.store(pos, std::memory_order_release);
+
+    return num;
+}
+
+//------------------------------------------------------------------------------
+
+FILE* Logger::getFile (const char* logname)
+{
+    size_t i = 0;
+    for (; (i < LOG_MAX_FILES) && (files_[i].name != nullptr); ++i)
+        if ((files_[i].name == logname) || (strcmp(files_[i].name, logname) == 0))
+            return files_[i].file;
+
+    if (i == LOG_MAX_FILES) return nullptr;
+
+    FILE* log = fopen(logname, "a");
+    if (log == nullptr) return nullptr;
+
+    files_[i].name = logname;
+    files_[i].file = log;
+
+    return log;
+}
+
+//------------------------------------------------------------------------------
+
+Logger& GetLogger ()
+{
+    static Logger logger;
+
+    return logger;
+}
+
+//------------------------------------------------------------------------------
+
+int LogWrite (int level, const char* logname, const char* format, ...)
+{
+    assert(format != nullptr);
+
+    va_list args;
+
+    va_start(args, format);
+    int err = GetLogger().Write(level, logname, format, args);
+    va_end(args);
+
+    return err;
+}
+
+//------------------------------------------------------------------------------
+
+int LogError (const char* logname, const char* lib, const char* file, int line, const char* function, int err, const char* errstr)
+{
+    assert(lib      != nullptr);
+    assert(file     != nullptr);
+    assert(function != nullptr);
+    assert(errstr   != nullptr);
+
+    return LogWrite(LOG_ERROR, logname, "lib=%s file=%s line=%d func=\"%s\" code=%d error=\"%s\"",
+                    lib, file, line, function, err, errstr);
+}
+
+//------------------------------------------------------------------------------
+
+bool LogEnabled (int level)
+{
+    return GetLogger().isEnabled(level);
+}
+
+//------------------------------------------------------------------------------
+
+void LogFlush ()
+{
+    GetLogger().Flush();
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,227 @@
+/*------------------------------------------------------------------------------
+    * File:        Log.h                                                       *
+    * Description: Declaration of functions and data types used for the        *
+                   asynchronous logging.                                       *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#ifndef LOG_H_INCLUDED
+#define LOG_H_INCLUDED
+
+#define _CRT_SECURE_NO_WARNINGS
+
+
+#include "LogConfig.h"
+#include <assert.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <new>
+
+
+struct LogSlot
+{
+    std::atomic<size_t> seq;
+
+    const char* logname = nullptr;
+    int         level   = LOG_INFO;
+    time_t      time    = 0;
+    char        text[LOG_RECORD_SIZE] = "";
+};
+
+struct LogFile
+{
+    const char* name = nullptr;
+    FILE*       file = nullptr;
+};
+
+/*------------------------------------------------------------------------------
+    Logger is a ring of records filled by any thread without locks and a writer
+    thread which formats them into lines of key=value pairs and appends them to
+    the log files. A thread that logs only prints the record into a free slot,
+    when the ring is full the record is dropped and counted, so logging never
+    waits for the disk.
+*///----------------------------------------------------------------------------
+
+class Logger
+{
+    int state_;
+
+    LogSlot* ring_ = nullptr;
+
+    alignas(64) std::atomic<size_t> head_;
+    alignas(64) std::atomic<size_t> tail_;
+
+    std::atomic<size_t> dropped_;
+    std::atomic<int>    level_;
+    std::atomic<bool>   running_;
+
+    LogFile     files_[LOG_MAX_FILES];
+    std::thread writer_;
+
+public:
+
+//------------------------------------------------------------------------------
+/*! @brief   Logger constructor, starts the writer thread.
+ */
+
+    Logger ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Logger copy constructor (deleted).
+ *
+ *  @param   obj         Source logger
+ */
+
+    Logger (const Logger& obj);
+
+    Logger& operator = (const Logger& obj); // deleted
+
+//------------------------------------------------------------------------------
+/*! @brief   Logger destructor, writes the rest of the records and stops the writer thread.
+ */
+
+   ~Logger ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Put the record into the ring.
+ *
+ *  @param   level       Level of the record
+ *  @param   logname     Name of the log file
+ *  @param   format      Format of the key=value pairs of the record
+ *  @param   args        Arguments of the format
+ *
+ *  @return  error code
+ */
+
+    int Write (int level, const char* logname, const char* format, va_list args);
+
+//------------------------------------------------------------------------------
+/*! @brief   Wait until all records put before the call are written.
+ */
+
+    void Flush ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Check that records of the level are written.
+ *
+ *  @param   level       Level of the record
+ *
+ *  @return  true if the level is not filtered, else false
+ */
+
+    bool isEnabled (int level) const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Set the lowest level of the written records.
+ *
+ *  @param   level       Level
+ */
+
+    void setLevel (int level);
+
+//------------------------------------------------------------------------------
+/*! @brief   Get number of records dropped because the ring was full.
+ *
+ *  @return  number of dropped records
+ */
+
+    size_t getDropped () const;
+
+//------------------------------------------------------------------------------
+
+private:
+
+//------------------------------------------------------------------------------
+/*! @brief   Loop of the writer thread.
+ */
+
+    void Run ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Write all records from the ring.
+ *
+ *  @return  number of written records
+ */
+
+    size_t Drain ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Get the opened log file, open it at the first record.
+ *
+ *  @param   logname     Name of the log file
+ *
+ *  @return  pointer to the file, nullptr if it can not be opened
+ */
+
+    FILE* getFile (const char* logname);
+
+//------------------------------------------------------------------------------
+};
+
+//------------------------------------------------------------------------------
+/*! @brief   Get the logger of the program, it is created at the first call.
+ *
+ *  @return  logger
+ */
+
+Logger& GetLogger ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Put the record into the log of the program.
+ *
+ *  @note    Record is written as "time=... level=..." and the formatted pairs,
+ *           values with spaces are quoted by the format.
+ *
+ *  @param   level       Level of the record
+ *  @param   logname     Name of the log file
+ *  @param   format      Format of the key=value pairs of the record
+ *
+ *  @return  error code
+ */
+
+int LogWrite (int level, const char* logname, const char* format, ...);
+
+//------------------------------------------------------------------------------
+/*! @brief   Put the error record with the place of the error into the log of the program.
+ *
+ *  @param   logname     Name of the log file
+ *  @param   lib         Name of the library
+ *  @param   file        Name of the program file
+ *  @param   line        Number of line with an error
+ *  @param   function    Name of the function with an error
+ *  @param   err         Error code
+ *  @param   errstr      Description of the error
+ *
+ *  @return  error code
+ */
+
+int LogError (const char* logname, const char* lib, const char* file, int line, const char* function, int err, const char* errstr);
+
+//------------------------------------------------------------------------------
+/*! @brief   Check that records of the level are written to the log of the program.
+ *
+ *  @param   level       Level of the record
+ *
+ *  @return  true if the level is not filtered, else false
+ */
+
+bool LogEnabled (int level);
+
+//------------------------------------------------------------------------------
+/*! @brief   Wait until all records of the program put before the call are written.
+ */
+
+void LogFlush ();
+
+//------------------------------------------------------------------------------
+
+#endif // LOG_H_INCLUDED
@@ -0,0 +1,90 @@
+/*------------------------------------------------------------------------------
+    * File:        LogConfig.h                                                 *
+    * Description: Log congigurations which define levels, constants and      *
+                   errors of the logging subsystem                             *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#ifndef LOG_CONFIG_H_INCLUDED
+#define LOG_CONFIG_H_INCLUDED
+
+
+#include <stdlib.h>
+#include <time.h>
+
+
+#if defined (__GNUC__) || defined (__clang__) || defined (__clang_major__)
+    #define __FUNC_NAME__   __PRETTY_FUNCTION__
+
+#elif defined (_MSC_VER)
+    #define __FUNC_NAME__   __FUNCSIG__
+
+#else
+    #define __FUNC_NAME__   __FUNCTION__
+
+#endif
+
+
+const size_t LOG_RING_SIZE   = 1 << 10; // power of two
+const size_t LOG_RECORD_SIZE = 512;
+const size_t LOG_MAX_FILES   = 16;
+const int    LOG_IDLE_WAIT   = 10;      // ms
+
+#ifdef  NO_DUMP
+
+    #define LOG_DEFAULT_LEVEL LOG_INFO
+
+#else
+
+    #define LOG_DEFAULT_LEVEL LOG_DEBUG
+
+#endif // NO_DUMP
+
+
+enum LogLevels
+{
+    LOG_DEBUG                                                          ,
+    LOG_INFO                                                           ,
+    LOG_WARN                                                           ,
+    LOG_ERROR                                                          ,
+};
+
+char const * const log_lvlstr[] =
+{
+    "debug"                                                            ,
+    "info"                                                             ,
+    "warn"                                                             ,
+    "error"                                                            ,
+};
+
+
+enum LogErrors
+{
+    LOG_NOT_OK = -1                                                    ,
+    LOG_OK = 0                                                         ,
+    LOG_NO_MEMORY                                                      ,
+
+    LOG_DESTRUCTED                                                     ,
+    LOG_LEVEL_FILTERED                                                 ,
+    LOG_NULL_INPUT_LOGNAME                                             ,
+    LOG_RING_FULL                                                      ,
+};
+
+char const * const log_errstr[] =
+{
+    "ERROR"                                                            ,
+    "OK"                                                               ,
+    "Failed to allocate memory"                                        ,
+
+    "Logger has already destructed"                                    ,
+    "Record is below the level of the logger"                          ,
+    "The input value of the log filename turned out to be zero"        ,
+    "Ring of the log records is full, record is dropped"               ,
+};
+
+
+#endif // LOG_CONFIG_H_INCLUDED
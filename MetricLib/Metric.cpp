@@ -0,0 +1,385 @@
+/*------------------------------------------------------------------------------
+    * File:        Metric.cpp                                                  *
+    * Description: Functions for the counters and latency histograms.          *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#include "Metric.h"
+
+//------------------------------------------------------------------------------
+
+// bounds of the exported buckets in nanoseconds, 1 us to 10 s
+static const unsigned long long latency_bounds[] =
+{
+    1000ULL,       5000ULL,
+    10000ULL,      50000ULL,
+    100000ULL,     500000ULL,
+    1000000ULL,    5000000ULL,
+    10000000ULL,   50000000ULL,
+    100000000ULL,  500000000ULL,
+    1000000000ULL, 5000000000ULL,
+    10000000000ULL,
+};
+
+static const double latency_quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+
+//------------------------------------------------------------------------------
+
+static double toSeconds (unsigned long long ns)
+{
+    return (double)ns / 1e9;
+}
+
+//------------------------------------------------------------------------------
+
+Histogram::Histogram () :
+    count_ (0),
+    sum_   (0),
+    max_   (0)
+{
+    for (size_t i = 0; i < MET_BUCKETS; ++i)
+        buckets_[i].store(0, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+void Histogram::Record (unsigned long long value)
+{
+    buckets_[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1,     std::memory_order_relaxed);
+    sum_  .fetch_add(value, std::memory_order_relaxed);
+
+    unsigned long long max = max_.load(std::memory_order_relaxed);
+    while ((value > max) && (not max_.compare_exchange_weak(max, value, std::memory_order_relaxed))) {}
+}
+
+//------------------------------------------------------------------------------
+
+unsigned long long Histogram::getCount () const
+{
+    return count_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+unsigned long long Histogram::getSum () const
+{
+    return sum_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+unsigned long long Histogram::getMax () const
+{
+    return max_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+unsigned long long Histogram::getCountBelow (unsigned long long bound) const
+{
+    unsigned long long num = 0;
+
+    for (size_t i = 0; (i < MET_BUCKETS) && (bucketTop(i) <= bound); ++i)
+        num += buckets_[i].load(std::memory_order_relaxed);
+
+    return num;
+}
+
+//------------------------------------------------------------------------------
+
+unsigned long long Histogram::getQuantile (double q) const
+{
+    unsigned long long count = getCount();
+    if (count == 0) return 0;
+
+    unsigned long long rank = (unsigned long long)(q * count);
+    if (rank < 1)     rank = 1;
+    if (rank > count) rank = count;
+
+    unsigned long long num = 0;
+    for (size_t i = 0; i < MET_BUCKETS; ++i)
+    {
+        num += buckets_[i].load(std::memory_order_relaxed);
+        if (num >= rank)
+        {
+            unsigned long long top = bucketTop(i);
+            unsigned long long max = getMax();
+
+            return (top < max) ? top : max;
+        }
+    }
+
+    return getMax();
+}
+
+//------------------------------------------------------------------------------
+
+size_t Histogram::bucketOf (unsigned long long value)
+{
+    const unsigned long long sub_num = 1ULL << MET_SUB_BITS;
+    if (value < sub_num) return (size_t)value;
+
+    size_t msb = 0;
+    for (unsigned long long v = value; v > 1; v >>= 1) ++msb;
+
+    size_t shift = msb - MET_SUB_BITS;
+    size_t sub   = (size_t)((value >> shift) & (sub_num - 1));
+
+    size_t bucket = ((shift + 1) << MET_SUB_BITS) | sub;
+
+    return (bucket < MET_BUCKETS) ? bucket : MET_BUCKETS - 1;
+}
+
+//------------------------------------------------------------------------------
+
+unsigned long long Histogram::bucketTop (size_t bucket)
+{
+    const unsigned long long sub_num = 1ULL << MET_SUB_BITS;
+    if (bucket < sub_num) return bucket;
+
+    size_t shift = (bucket >> MET_SUB_BITS) - 1;
+    size_t sub   = bucket & (sub_num - 1);
+
+    return ((sub_num + sub) << shift) + (1ULL << shift) - 1;
+}
+
+//------------------------------------------------------------------------------
+
+Metrics::Metrics ()
+{
+    for (size_t i = 0; i < MET_COUNTERS_NUM; ++i)
+        counters_[i].store(0, std::memory_order_relaxed);
+
+    for (size_t i = 0; i <= MET_MAX_DEPTH; ++i)
+        depths_[i].store(0, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < MEM_NUM; ++i)
+    {
+        mem_bytes_ [i].store(0, std::memory_order_relaxed);
+        mem_blocks_[i].store(0, std::memory_order_relaxed);
+        mem_peak_  [i].store(0, std::memory_order_relaxed);
+        mem_allocs_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void Metrics::addLatency (int op, unsigned long long ns)
+{
+    assert((0 <= op) && (op < MET_OPS_NUM));
+
+    latency_[op].Record(ns);
+}
+
+//------------------------------------------------------------------------------
+
+void Metrics::addCount (int counter, unsigned long long num)
+{
+    assert((0 <= counter) && (counter < MET_COUNTERS_NUM));
+
+    counters_[counter].fetch_add(num, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+void Metrics::addDepth (size_t depth)
+{
+    if (depth > MET_MAX_DEPTH) depth = MET_MAX_DEPTH;
+
+    depths_[depth].fetch_add(1, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+void Metrics::addAlloc (int mem, size_t bytes)
+{
+    assert((0 <= mem) && (mem < MEM_NUM));
+
+    long long cur = mem_bytes_[mem].fetch_add((long long)bytes, std::memory_order_relaxed) + (long long)bytes;
+    mem_blocks_[mem].fetch_add(1, std::memory_order_relaxed);
+    mem_allocs_[mem].fetch_add(1, std::memory_order_relaxed);
+
+    long long peak = mem_peak_[mem].load(std::memory_order_relaxed);
+    while ((cur > peak) && (not mem_peak_[mem].compare_exchange_weak(peak, cur, std::memory_order_relaxed))) {}
+}
+
+//------------------------------------------------------------------------------
+
+void Metrics::addFree (int mem, size_t bytes)
+{
+    assert((0 <= mem) && (mem < MEM_NUM));
+
+    mem_bytes_ [mem].fetch_sub((long long)bytes, std::memory_order_relaxed);
+    mem_blocks_[mem].fetch_sub(1, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+const Histogram& Metrics::getLatency (int op) const
+{
+    assert((0 <= op) && (op < MET_OPS_NUM));
+
+    return latency_[op];
+}
+
+//------------------------------------------------------------------------------
+
+unsigned long long Metrics::getCount (int counter) const
+{
+    assert((0 <= counter) && (counter < MET_COUNTERS_NUM));
+
+    return counters_[counter].load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+void Metrics::getMemory (int mem, long long& bytes, long long& blocks, long long& peak, unsigned long long& allocs) const
+{
+    assert((0 <= mem) && (mem < MEM_NUM));
+
+    bytes  = mem_bytes_ [mem].load(std::memory_order_relaxed);
+    blocks = mem_blocks_[mem].load(std::memory_order_relaxed);
+    peak   = mem_peak_  [mem].load(std::memory_order_relaxed);
+    allocs = mem_allocs_[mem].load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+int Metrics::Write (FILE* fp) const
+{
+    assert(fp != nullptr);
+
+    fprintf(fp, "# HELP %s_op_duration_seconds Latency of the operations.\n", METRICS_PREFIX);
+    fprintf(fp, "# TYPE %s_op_duration_seconds histogram\n",                  METRICS_PREFIX);
+
+    for (int op = 0; op < MET_OPS_NUM; ++op)
+    {
+        const Histogram& hist = latency_[op];
+
+        for (size_t i = 0; i < sizeof(latency_bounds) / sizeof(latency_bounds[0]); ++i)
+            fprintf(fp, "%s_op_duration_seconds_bucket{op=\"%s\",le=\"%g\"} %llu\n",
+                    METRICS_PREFIX, met_opstr[op], toSeconds(latency_bounds[i]), hist.getCountBelow(latency_bounds[i]));
+
+        fprintf(fp, "%s_op_duration_seconds_bucket{op=\"%s\",le=\"+Inf\"} %llu\n", METRICS_PREFIX, met_opstr[op], hist.getCount());
+        fprintf(fp, "%s_op_duration_seconds_sum{op=\"%s\"} %.9f\n",              METRICS_PREFIX, met_opstr[op], toSeconds(hist.getSum()));
+        fprintf(fp, "%s_op_duration_seconds_count{op=\"%s\"} %llu\n",            METRICS_PREFIX, met_opstr[op], hist.getCount());
+    }
+
+    fprintf(fp, "# HELP %s_op_duration_quantile_seconds Quantiles of the latency with the relative error below %.2f%%.\n",
+            METRICS_PREFIX, 100.0 / (1 << MET_SUB_BITS));
+    fprintf(fp, "# TYPE %s_op_duration_quantile_seconds gauge\n", METRICS_PREFIX);
+
+    for (int op = 0; op < MET_OPS_NUM; ++op)
+    {
+        for (size_t i = 0; i < sizeof(latency_quantiles) / sizeof(latency_quantiles[0]); ++i)
+            fprintf(fp, "%s_op_duration_quantile_seconds{op=\"%s\",quantile=\"%g\"} %.9f\n",
+                    METRICS_PREFIX, met_opstr[op], latency_quantiles[i], toSeconds(latency_[op].getQuantile(latency_quantiles[i])));
+
+        fprintf(fp, "%s_op_duration_quantile_seconds{op=\"%s\",quantile=\"1\"} %.9f\n",
+                METRICS_PREFIX, met_opstr[op], toSeconds(latency_[op].getMax()));
+    }
+
+    for (int counter = 0; counter < MET_COUNTERS_NUM; ++counter)
+    {
+        fprintf(fp, "# TYPE %s_%s counter\n", METRICS_PREFIX, met_cntstr[counter]);
+        fprintf(fp, "%s_%s %llu\n",           METRICS_PREFIX, met_cntstr[counter], getCount(counter));
+    }
+
+    const char* mem_names[] = { "memory_bytes", "memory_blocks", "memory_peak_bytes" };
+    const char* mem_helps[] = { "Bytes in use", "Blocks in use", "Peak of bytes in use" };
+
+    for (int i = 0; i < 3; ++i)
+    {
+        fprintf(fp, "# HELP %s_%s %s by the subsystem.\n", METRICS_PREFIX, mem_names[i], mem_helps[i]);
+        fprintf(fp, "# TYPE %s_%s gauge\n",                METRICS_PREFIX, mem_names[i]);
+
+        for (int mem = 0; mem < MEM_NUM; ++mem)
+        {
+            long long          values[3] = {};
+            unsigned long long allocs    = 0;
+            getMemory(mem, values[0], values[1], values[2], allocs);
+
+            fprintf(fp, "%s_%s{subsystem=\"%s\"} %lld\n", METRICS_PREFIX, mem_names[i], met_memstr[mem], values[i]);
+        }
+    }
+
+    fprintf(fp, "# HELP %s_memory_allocations_total Allocations of the subsystem.\n", METRICS_PREFIX);
+    fprintf(fp, "# TYPE %s_memory_allocations_total counter\n",                        METRICS_PREFIX);
+
+    for (int mem = 0; mem < MEM_NUM; ++mem)
+        fprintf(fp, "%s_memory_allocations_total{subsystem=\"%s\"} %llu\n",
+                METRICS_PREFIX, met_memstr[mem], mem_allocs_[mem].load(std::memory_order_relaxed));
+
+    fprintf(fp, "# HELP %s_guess_depth Depth of the nodes where the games ended.\n", METRICS_PREFIX);
+    fprintf(fp, "# TYPE %s_guess_depth histogram\n",                               METRICS_PREFIX);
+
+    size_t last = 0;
+    for (size_t depth = 0; depth <= MET_MAX_DEPTH; ++depth)
+        if (depths_[depth].load(std::memory_order_relaxed) != 0) last = depth;
+
+    unsigned long long num = 0;
+    unsigned long long sum = 0;
+    for (size_t depth = 0; depth <= last; ++depth)
+    {
+        unsigned long long cur = depths_[depth].load(std::memory_order_relaxed);
+        num += cur;
+        sum += cur * depth;
+
+        fprintf(fp, "%s_guess_depth_bucket{le=\"%lu\"} %llu\n", METRICS_PREFIX, depth, num);
+    }
+
+    fprintf(fp, "%s_guess_depth_bucket{le=\"+Inf\"} %llu\n", METRICS_PREFIX, num);
+    fprintf(fp, "%s_guess_depth_sum %llu\n",                 METRICS_PREFIX, sum);
+    fprintf(fp, "%s_guess_depth_count %llu\n",               METRICS_PREFIX, num);
+
+    return MET_OK;
+}
+
+//------------------------------------------------------------------------------
+
+int Metrics::Write (const char* filename) const
+{
+    if (filename == nullptr) return MET_NULL_INPUT_FILENAME;
+
+    FILE* fp = fopen(filename, "w");
+    if (fp == nullptr) return MET_FILE_NOT_OPENED;
+
+    int err = Write(fp);
+
+    fclose(fp);
+
+    return err;
+}
+
+//------------------------------------------------------------------------------
+
+ScopedTimer::ScopedTimer (int op) :
+    op_    (op),
+    start_ (std::chrono::steady_clock::now())
+{
+}
+
+//------------------------------------------------------------------------------
+
+ScopedTimer::~ScopedTimer ()
+{
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+
+    GetMetrics().addLatency(op_, (ns > 0) ? (unsigned long long)ns : 0);
+}
+
+//------------------------------------------------------------------------------
+
+Metrics& GetMetrics ()
+{
+    static Metrics metrics;
+
+    return metrics;
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,300 @@
+/*------------------------------------------------------------------------------
+    * File:        Metric.h                                                    *
+    * Description: Declaration of functions and data types used for the        *
+                   counters and latency histograms of the operations.          *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#ifndef METRIC_H_INCLUDED
+#define METRIC_H_INCLUDED
+
+#define _CRT_SECURE_NO_WARNINGS
+
+
+#include "MetricConfig.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+
+
+/*------------------------------------------------------------------------------
+    Histogram keeps values with the fixed relative error like HDR histograms:
+    values below 2^MET_SUB_BITS have their own buckets, every next power of two
+    is split into 2^MET_SUB_BITS equal buckets. Recording is a few relaxed
+    atomic additions, so it is done from any thread without locks.
+*///----------------------------------------------------------------------------
+
+class Histogram
+{
+    std::atomic<unsigned long long> buckets_[MET_BUCKETS];
+
+    std::atomic<unsigned long long> count_;
+    std::atomic<unsigned long long> sum_;
+    std::atomic<unsigned long long> max_;
+
+public:
+
+//------------------------------------------------------------------------------
+/*! @brief   Histogram constructor.
+ */
+
+    Histogram ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Add value to the histogram.
+ *
+ *  @param   value       Value
+ */
+
+    void Record (unsigned long long value);
+
+//------------------------------------------------------------------------------
+/*! @brief   Get number of values.
+ *
+ *  @return  number of values
+ */
+
+    unsigned long long getCount () const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Get sum of values.
+ *
+ *  @return  sum of values
+ */
+
+    unsigned long long getSum () const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Get maximum value.
+ *
+ *  @return  maximum value
+ */
+
+    unsigned long long getMax () const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Get number of values not greater than the bound.
+ *
+ *  @param   bound       Bound
+ *
+ *  @return  number of values in buckets which end not after the bound
+ */
+
+    unsigned long long getCountBelow (unsigned long long bound) const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Get quantile of values.
+ *
+ *  @param   q           Quantile from 0 to 1
+ *
+ *  @return  upper end of the bucket with the quantile
+ */
+
+    unsigned long long getQuantile (double q) const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Get bucket of the value.
+ *
+ *  @param   value       Value
+ *
+ *  @return  bucket number
+ */
+
+    static size_t bucketOf (unsigned long long value);
+
+//------------------------------------------------------------------------------
+/*! @brief   Get the greatest value of the bucket.
+ *
+ *  @param   bucket      Bucket number
+ *
+ *  @return  upper end of the bucket
+ */
+
+    static unsigned long long bucketTop (size_t bucket);
+
+//------------------------------------------------------------------------------
+};
+
+/*------------------------------------------------------------------------------
+    Metrics of the program are latencies of the operations in nanoseconds,
+    counters of events, distribution of the depths of the guessed nodes and
+    memory of the subsystems: bytes and blocks in use, the peak of bytes and
+    the number of allocations.
+*///----------------------------------------------------------------------------
+
+class Metrics
+{
+    Histogram latency_[MET_OPS_NUM];
+
+    std::atomic<unsigned long long> counters_[MET_COUNTERS_NUM];
+    std::atomic<unsigned long long> depths_[MET_MAX_DEPTH + 1];
+
+    std::atomic<long long>          mem_bytes_ [MEM_NUM];
+    std::atomic<long long>          mem_blocks_[MEM_NUM];
+    std::atomic<long long>          mem_peak_  [MEM_NUM];
+    std::atomic<unsigned long long> mem_allocs_[MEM_NUM];
+
+public:
+
+//------------------------------------------------------------------------------
+/*! @brief   Metrics constructor.
+ */
+
+    Metrics ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Add latency of the operation.
+ *
+ *  @param   op          Operation from MetricOps
+ *  @param   ns          Latency in nanoseconds
+ */
+
+    void addLatency (int op, unsigned long long ns);
+
+//------------------------------------------------------------------------------
+/*! @brief   Add to the counter.
+ *
+ *  @param   counter     Counter from MetricCounters
+ *  @param   num         Number to add
+ */
+
+    void addCount (int counter, unsigned long long num = 1);
+
+//------------------------------------------------------------------------------
+/*! @brief   Add depth of the guessed node, deeper nodes are counted as MET_MAX_DEPTH.
+ *
+ *  @param   depth       Depth of the node
+ */
+
+    void addDepth (size_t depth);
+
+//------------------------------------------------------------------------------
+/*! @brief   Add allocated block of the subsystem.
+ *
+ *  @param   mem         Subsystem from MetricMemory
+ *  @param   bytes       Size of the block
+ */
+
+    void addAlloc (int mem, size_t bytes);
+
+//------------------------------------------------------------------------------
+/*! @brief   Remove freed block of the subsystem.
+ *
+ *  @param   mem         Subsystem from MetricMemory
+ *  @param   bytes       Size of the block, the same as it was added with
+ */
+
+    void addFree (int mem, size_t bytes);
+
+//------------------------------------------------------------------------------
+/*! @brief   Get latency histogram of the operation.
+ *
+ *  @param   op          Operation from MetricOps
+ *
+ *  @return  histogram
+ */
+
+    const Histogram& getLatency (int op) const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Get value of the counter.
+ *
+ *  @param   counter     Counter from MetricCounters
+ *
+ *  @return  value of the counter
+ */
+
+    unsigned long long getCount (int counter) const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Get memory of the subsystem.
+ *
+ *  @param   mem         Subsystem from MetricMemory
+ *  @param   bytes       Bytes in use
+ *  @param   blocks      Blocks in use
+ *  @param   peak        Peak of bytes in use
+ *  @param   allocs      Number of allocations
+ */
+
+    void getMemory (int mem, long long& bytes, long long& blocks, long long& peak, unsigned long long& allocs) const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Write metrics in the Prometheus text format.
+ *
+ *  @param   fp          Pointer to output
+ *
+ *  @return  error code
+ */
+
+    int Write (FILE* fp) const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Write metrics in the Prometheus text format to the file.
+ *
+ *  @param   filename    Name of the metrics file
+ *
+ *  @return  error code
+ */
+
+    int Write (const char* filename) const;
+
+//------------------------------------------------------------------------------
+};
+
+/*------------------------------------------------------------------------------
+    Timer adds the time from its construction to its destruction to the
+    latency of the operation, use it by MET_TIMER(op) at the function start.
+*///----------------------------------------------------------------------------
+
+class ScopedTimer
+{
+    int op_;
+
+    std::chrono::steady_clock::time_point start_;
+
+public:
+
+//------------------------------------------------------------------------------
+/*! @brief   Timer constructor, starts the timer.
+ *
+ *  @param   op          Operation from MetricOps
+ */
+
+    explicit ScopedTimer (int op);
+
+//------------------------------------------------------------------------------
+/*! @brief   Timer copy constructor (deleted).
+ *
+ *  @param   obj         Source timer
+ */
+
+    ScopedTimer (const ScopedTimer& obj);
+
+    ScopedTimer& operator = (const ScopedTimer& obj); // deleted
+
+//------------------------------------------------------------------------------
+/*! @brief   Timer destructor, adds the latency.
+ */
+
+   ~ScopedTimer ();
+
+//------------------------------------------------------------------------------
+};
+
+//------------------------------------------------------------------------------
+/*! @brief   Get metrics of the program, they are created at the first call.
+ *
+ *  @return  metrics
+ */
+
+Metrics& GetMetrics ();
+
+//------------------------------------------------------------------------------
+
+#endif // METRIC_H_INCLUDED
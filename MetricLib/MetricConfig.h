@@ -0,0 +1,132 @@
+/*------------------------------------------------------------------------------
+    * File:        MetricConfig.h                                              *
+    * Description: Metric congigurations which define operations, counters    *
+                   and errors of the metrics                                   *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#ifndef METRIC_CONFIG_H_INCLUDED
+#define METRIC_CONFIG_H_INCLUDED
+
+
+#include <stdlib.h>
+
+
+#define MET_CONCAT_(a, b) a##b
+#define MET_CONCAT(a, b)  MET_CONCAT_(a, b)
+
+#ifdef  NO_METRICS
+
+    #define MET_TIMER(op)           ((void)0)
+    #define MET_COUNT(counter, num) ((void)0)
+    #define MET_DEPTH(depth)        ((void)0)
+    #define MET_ALLOC(mem, bytes)   ((void)0)
+    #define MET_FREE(mem, bytes)    ((void)0)
+
+#else
+
+    #define MET_TIMER(op)           ScopedTimer MET_CONCAT(met_timer_, __LINE__) (op)
+    #define MET_COUNT(counter, num) GetMetrics().addCount(counter, num)
+    #define MET_DEPTH(depth)        GetMetrics().addDepth(depth)
+    #define MET_ALLOC(mem, bytes)   GetMetrics().addAlloc(mem, bytes)
+    #define MET_FREE(mem, bytes)    GetMetrics().addFree(mem, bytes)
+
+#endif // NO_METRICS
+
+
+char const * const METRICS_FILENAME = "metrics.prom";
+char const * const METRICS_PREFIX   = "akinator";
+
+const size_t MET_SUB_BITS  = 4;  // 16 buckets in every power of two, error is below 6.25%
+const size_t MET_OCTAVES   = 40; // up to 2^44 ns, about 5 hours
+const size_t MET_BUCKETS   = (MET_OCTAVES + 1) << MET_SUB_BITS;
+const size_t MET_MAX_DEPTH = 64;
+
+
+enum MetricOps
+{
+    MET_LOAD                                                           ,
+    MET_CHECK                                                          ,
+    MET_FIND_PATH                                                      ,
+    MET_WRITE                                                          ,
+    MET_RELAYOUT                                                       ,
+    MET_FETCH_PAGE                                                     ,
+    MET_GUESSING                                                       ,
+
+    MET_OPS_NUM                                                        ,
+};
+
+char const * const met_opstr[] =
+{
+    "load"                                                             ,
+    "check"                                                            ,
+    "find_path"                                                        ,
+    "write"                                                            ,
+    "relayout"                                                         ,
+    "fetch_page"                                                       ,
+    "guessing"                                                         ,
+};
+
+enum MetricCounters
+{
+    MET_PAGE_LOADS                                                     ,
+    MET_PAGE_EVICTIONS                                                 ,
+    MET_GUESSES_RIGHT                                                  ,
+    MET_GUESSES_WRONG                                                  ,
+
+    MET_COUNTERS_NUM                                                   ,
+};
+
+char const * const met_cntstr[] =
+{
+    "page_loads_total"                                                 ,
+    "page_evictions_total"                                             ,
+    "guesses_right_total"                                              ,
+    "guesses_wrong_total"                                              ,
+};
+
+enum MetricMemory
+{
+    MEM_NODES                                                          ,
+    MEM_STRINGS                                                        ,
+    MEM_STACKS                                                         ,
+    MEM_TEXTS                                                          ,
+
+    MEM_NUM                                                            ,
+};
+
+char const * const met_memstr[] =
+{
+    "nodes"                                                            ,
+    "node_strings"                                                     ,
+    "stack_data"                                                       ,
+    "text_buffers"                                                     ,
+};
+
+
+enum MetricErrors
+{
+    MET_NOT_OK = -1                                                    ,
+    MET_OK = 0                                                         ,
+    MET_NO_MEMORY                                                      ,
+
+    MET_NULL_INPUT_FILENAME                                            ,
+    MET_FILE_NOT_OPENED                                                ,
+};
+
+char const * const met_errstr[] =
+{
+    "ERROR"                                                            ,
+    "OK"                                                               ,
+    "Failed to allocate memory"                                        ,
+
+    "The input value of the metrics filename turned out to be zero"    ,
+    "Failed to open the metrics file"                                  ,
+};
+
+
+#endif // METRIC_CONFIG_H_INCLUDED
@@ -0,0 +1,496 @@
+/*------------------------------------------------------------------------------
+    * File:        Pack.cpp                                                    *
+    * Description: Functions for the block compressed base.                   *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#include "Pack.h"
+
+//------------------------------------------------------------------------------
+
+static size_t blockEnd (const char* text, size_t size, size_t pos)
+{
+    if (size - pos <= PACK_BLOCK_SIZE) return size;
+
+    // blocks end on line ends, so every block is a piece of the base by itself
+    size_t end = pos + PACK_BLOCK_SIZE;
+    while ((end > pos) && (text[end - 1] != '\n')) --end;
+
+    return (end > pos) ? end : pos + PACK_BLOCK_SIZE;
+}
+
+//------------------------------------------------------------------------------
+
+PackFile::PackFile () :
+    state_ (PCK_OK)
+{
+}
+
+//------------------------------------------------------------------------------
+
+PackFile::~PackFile ()
+{
+    PCK_ASSERTOK((state_ == PCK_DESTRUCTED), PCK_DESTRUCTED);
+
+    Close();
+
+    state_ = PCK_DESTRUCTED;
+}
+
+//------------------------------------------------------------------------------
+
+int PackFile::Open (const char* filename)
+{
+    if (filename == nullptr) return PCK_NULL_INPUT_FILENAME;
+
+    Close();
+
+    file_ = fopen(filename, "rb");
+    if (file_ == nullptr) return PCK_FILE_NOT_OPENED;
+
+    if ((fread(&header_, sizeof(header_), 1, file_) != 1) ||
+        (memcmp(header_.sign, PACK_SIGN, strlen(PACK_SIGN) + 1) != 0))
+    {
+        Close();
+        return PCK_WRONG_SIGN;
+    }
+
+    fseek(file_, 0, SEEK_END);
+    unsigned long long file_size = ftell(file_);
+
+    unsigned long long data = sizeof(PackHeader) + header_.num * sizeof(PackEntry);
+
+    if ((header_.block == 0) || (header_.block > PACK_BLOCK_SIZE) || (data > file_size))
+    {
+        Close();
+        return PCK_WRONG_BLOCK_TABLE;
+    }
+
+    blocks_ = new (std::nothrow) PackEntry [header_.num + 1];
+    if (blocks_ == nullptr)
+    {
+        Close();
+        return PCK_NO_MEMORY;
+    }
+
+    fseek(file_, sizeof(PackHeader), SEEK_SET);
+    if ((header_.num != 0) && (fread(blocks_, sizeof(PackEntry), header_.num, file_) != header_.num))
+    {
+        Close();
+        return PCK_WRONG_BLOCK_TABLE;
+    }
+
+    unsigned long long raw = 0;
+
+    for (size_t i = 0; i < header_.num; ++i)
+    {
+        if ((blocks_[i].offset != data) || (blocks_[i].size > file_size - data) || (blocks_[i].raw > header_.block))
+        {
+            Close();
+            return PCK_WRONG_BLOCK_TABLE;
+        }
+
+        data += blocks_[i].size;
+        raw  += blocks_[i].raw;
+    }
+
+    if (raw != header_.size)
+    {
+        Close();
+        return PCK_WRONG_BLOCK_TABLE;
+    }
+
+    return PCK_OK;
+}
+
+//------------------------------------------------------------------------------
+
+void PackFile::Close ()
+{
+    if (file_ != nullptr) fclose(file_);
+    file_ = nullptr;
+
+    delete [] blocks_;
+    blocks_ = nullptr;
+
+    header_ = PackHeader();
+}
+
+//------------------------------------------------------------------------------
+
+size_t PackFile::getBlockNum () const
+{
+    return header_.num;
+}
+
+//------------------------------------------------------------------------------
+
+size_t PackFile::getSize () const
+{
+    return header_.size;
+}
+
+//------------------------------------------------------------------------------
+
+size_t PackFile::getBlockSize (size_t block) const
+{
+    return (block < header_.num) ? blocks_[block].raw : 0;
+}
+
+//------------------------------------------------------------------------------
+
+int PackFile::ReadBlock (size_t block, char* text)
+{
+    assert(text != nullptr);
+
+    if ((file_ == nullptr) || (block >= header_.num)) return PCK_WRONG_BLOCK_NUMBER;
+
+    char* packed = new (std::nothrow) char [blocks_[block].size + 1];
+    if (packed == nullptr) return PCK_NO_MEMORY;
+
+    fseek(file_, blocks_[block].offset, SEEK_SET);
+
+    int err = PCK_OK;
+    if (fread(packed, 1, blocks_[block].size, file_) != blocks_[block].size)
+        err = PCK_CORRUPTED_BLOCK;
+    else
+        err = UnpackBlock(packed, blocks_[block].size, text, blocks_[block].raw);
+
+    delete [] packed;
+
+    return err;
+}
+
+//------------------------------------------------------------------------------
+
+int PackFile::ReadAll (char*& text, size_t& size)
+{
+    if (file_ == nullptr) return PCK_FILE_NOT_OPENED;
+
+    text = nullptr;
+    size = 0;
+
+    if (header_.num == 0) return PCK_WRONG_BLOCK_TABLE;
+
+    unsigned long long begin  = blocks_[0].offset;
+    unsigned long long packed = blocks_[header_.num - 1].offset + blocks_[header_.num - 1].size - begin;
+
+    char* data = new (std::nothrow) char [packed + 1];
+    if (data == nullptr) return PCK_NO_MEMORY;
+
+    fseek(file_, begin, SEEK_SET);
+    if (fread(data, 1, packed, file_) != packed)
+    {
+        delete [] data;
+        return PCK_CORRUPTED_BLOCK;
+    }
+
+    text = (char*)calloc(header_.size + 2, 1);
+    if (text == nullptr)
+    {
+        delete [] data;
+        return PCK_NO_MEMORY;
+    }
+
+    // block offsets in the text, blocks are unpacked independently
+    size_t* starts = new size_t [header_.num];
+    for (size_t i = 0, pos = 0; i < header_.num; pos += blocks_[i++].raw)
+        starts[i] = pos;
+
+    std::atomic<int> err(PCK_OK);
+
+    GetThreadPool().ParallelFor(header_.num, [&] (size_t i)
+    {
+        int block_err = UnpackBlock(data + (blocks_[i].offset - begin), blocks_[i].size, text + starts[i], blocks_[i].raw);
+        if (block_err) err = block_err;
+    });
+
+    delete [] starts;
+    delete [] data;
+
+    if (err != PCK_OK)
+    {
+        free(text);
+        text = nullptr;
+        return err;
+    }
+
+    size = header_.size;
+
+    return PCK_OK;
+}
+
+//------------------------------------------------------------------------------
+
+bool IsPacked (const char* filename)
+{
+    assert(filename != nullptr);
+
+    FILE* fp = fopen(filename, "rb");
+    if (fp == nullptr) return false;
+
+    char sign[8] = "";
+    size_t read = fread(sign, 1, sizeof(sign), fp);
+    fclose(fp);
+
+    return (read == sizeof(sign)) && (memcmp(sign, PACK_SIGN, strlen(PACK_SIGN) + 1) == 0);
+}
+
+//------------------------------------------------------------------------------
+
+int PackText (const char* filename, const char* text, size_t size)
+{
+    if (filename == nullptr) return PCK_NULL_INPUT_FILENAME;
+    assert(text != nullptr);
+
+    PackHeader header;
+    strcpy(header.sign, PACK_SIGN);
+    header.size  = size;
+    header.block = PACK_BLOCK_SIZE;
+
+    size_t num = 0;
+    for (size_t pos = 0; pos < size; pos = blockEnd(text, size, pos)) ++num;
+
+    header.num = num;
+
+    PackEntry* blocks = new (std::nothrow) PackEntry [num + 1];
+    size_t*    starts = new (std::nothrow) size_t    [num + 1];
+    size_t*    bounds = new (std::nothrow) size_t    [num + 1];
+    if ((blocks == nullptr) || (starts == nullptr) || (bounds == nullptr))
+    {
+        delete [] blocks;
+        delete [] starts;
+        delete [] bounds;
+        return PCK_NO_MEMORY;
+    }
+
+    size_t bound = 0;
+    for (size_t pos = 0, end = 0, i = 0; pos < size; pos = end, ++i)
+    {
+        end = blockEnd(text, size, pos);
+
+        starts[i]     = pos;
+        bounds[i]     = bound;
+        blocks[i].raw = end - pos;
+        bound += PackBound(end - pos);
+    }
+
+    char* packed = new (std::nothrow) char [bound + 1];
+    if (packed == nullptr)
+    {
+        delete [] blocks;
+        delete [] starts;
+        delete [] bounds;
+        return PCK_NO_MEMORY;
+    }
+
+    GetThreadPool().ParallelFor(num, [&] (size_t i)
+    {
+        blocks[i].size = PackBlock(text + starts[i], blocks[i].raw, packed + bounds[i]);
+    });
+
+    unsigned long long offset = sizeof(PackHeader) + num * sizeof(PackEntry);
+    for (size_t i = 0; i < num; ++i)
+    {
+        blocks[i].offset = offset;
+        offset += blocks[i].size;
+    }
+
+    int err = PCK_OK;
+
+    FILE* fp = fopen(filename, "wb");
+    if (fp == nullptr) err = PCK_FILE_NOT_OPENED;
+    else
+    {
+        fwrite(&header, sizeof(header), 1, fp);
+        if (num != 0) fwrite(blocks, sizeof(PackEntry), num, fp);
+
+        for (size_t i = 0; i < num; ++i)
+            fwrite(packed + bounds[i], 1, blocks[i].size, fp);
+
+        fclose(fp);
+    }
+
+    delete [] packed;
+    delete [] blocks;
+    delete [] starts;
+    delete [] bounds;
+
+    return err;
+}
+
+//------------------------------------------------------------------------------
+
+size_t PackBound (size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+//------------------------------------------------------------------------------
+
+static inline unsigned int read32 (const unsigned char* ptr)
+{
+    unsigned int value = 0;
+    memcpy(&value, ptr, sizeof(value));
+
+    return value;
+}
+
+//------------------------------------------------------------------------------
+
+static inline unsigned char* putLength (unsigned char* dst, size_t len)
+{
+    for (; len >= 255; len -= 255) *dst++ = 255;
+    *dst++ = (unsigned char)len;
+
+    return dst;
+}
+
+//------------------------------------------------------------------------------
+
+static inline unsigned char* putLiterals (unsigned char* dst, const unsigned char* src, size_t len, size_t match)
+{
+    *dst++ = (unsigned char)(((len < 15) ? len : 15) << 4 | ((match < 15) ? match : 15));
+    if (len >= 15) dst = putLength(dst, len - 15);
+
+    memcpy(dst, src, len);
+
+    return dst + len;
+}
+
+//------------------------------------------------------------------------------
+
+size_t PackBlock (const char* src, size_t size, char* dst)
+{
+    assert(src  != nullptr);
+    assert(dst  != nullptr);
+    assert(size <= PACK_BLOCK_SIZE);
+
+    const unsigned char* in  = (const unsigned char*)src;
+    unsigned char*       out = (unsigned char*)dst;
+
+    int table[1 << PACK_HASH_BITS];
+    for (size_t i = 0; i < (1 << PACK_HASH_BITS); ++i) table[i] = -1;
+
+    size_t pos    = 0;
+    size_t anchor = 0;
+    size_t limit  = (size > PACK_MIN_MATCH + 8) ? size - PACK_MIN_MATCH - 8 : 0;
+
+    while (pos < limit)
+    {
+        unsigned int seq  = read32(in + pos);
+        size_t       hash = (seq * 2654435761u) >> (32 - PACK_HASH_BITS);
+
+        int ref = table[hash];
+        table[hash] = (int)pos;
+
+        if ((ref < 0) || (read32(in + ref) != seq))
+        {
+            ++pos;
+            continue;
+        }
+
+        size_t len = PACK_MIN_MATCH;
+        while ((pos + len < size) && (in[ref + len] == in[pos + len])) ++len;
+
+        size_t offset = pos - ref;
+
+        out = putLiterals(out, in + anchor, pos - anchor, len - PACK_MIN_MATCH);
+        *out++ = (unsigned char)(offset & 0xFF);
+        *out++ = (unsigned char)(offset >> 8);
+        if (len - PACK_MIN_MATCH >= 15) out = putLength(out, len - PACK_MIN_MATCH - 15);
+
+        pos   += len;
+        anchor = pos;
+    }
+
+    out = putLiterals(out, in + anchor, size - anchor, 0);
+
+    return out - (unsigned char*)dst;
+}
+
+//------------------------------------------------------------------------------
+
+int UnpackBlock (const char* src, size_t size, char* dst, size_t raw)
+{
+    assert(src != nullptr);
+    assert(dst != nullptr);
+
+    const unsigned char* in  = (const unsigned char*)src;
+    unsigned char*       out = (unsigned char*)dst;
+
+    size_t ip = 0;
+    size_t op = 0;
+
+    while (ip < size)
+    {
+        unsigned char token = in[ip++];
+
+        size_t len = token >> 4;
+        if (len == 15)
+        {
+            unsigned char add = 255;
+            while (add == 255)
+            {
+                if (ip >= size) return PCK_CORRUPTED_BLOCK;
+                add  = in[ip++];
+                len += add;
+            }
+        }
+
+        if ((len > size - ip) || (len > raw - op)) return PCK_CORRUPTED_BLOCK;
+
+        memcpy(out + op, in + ip, len);
+        ip += len;
+        op += len;
+
+        // the last run has no match
+        if (ip == size) break;
+
+        if (size - ip < 2) return PCK_CORRUPTED_BLOCK;
+
+        size_t offset = in[ip] | (in[ip + 1] << 8);
+        ip += 2;
+
+        len = token & 15;
+        if (len == 15)
+        {
+            unsigned char add = 255;
+            while (add == 255)
+            {
+                if (ip >= size) return PCK_CORRUPTED_BLOCK;
+                add  = in[ip++];
+                len += add;
+            }
+        }
+        len += PACK_MIN_MATCH;
+
+        if ((offset == 0) || (offset > op) || (len > raw - op)) return PCK_CORRUPTED_BLOCK;
+
+        // match may overlap the output, so it is copied by bytes
+        for (size_t i = 0; i < len; ++i, ++op)
+            out[op] = out[op - offset];
+    }
+
+    return (op == raw) ? PCK_OK : PCK_CORRUPTED_BLOCK;
+}
+
+//------------------------------------------------------------------------------
+
+void PckPrintError (const char* logname, const char* file, int line, const char* function, int err)
+{
+    assert(function != nullptr);
+    assert(logname  != nullptr);
+    assert(file     != nullptr);
+
+    LogError(logname, "pack", file, line, function, err, pck_errstr[err + 1]);
+
+    printf (     "ERROR: file %s  line %d  function %s\n",   file, line, function);
+    printf (     "%s\n\n", pck_errstr[err + 1]);
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,212 @@
+/*------------------------------------------------------------------------------
+    * File:        Pack.h                                                      *
+    * Description: Declaration of functions and data types used for the        *
+                   block compressed base.                                      *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#ifndef PACK_H_INCLUDED
+#define PACK_H_INCLUDED
+
+#define _CRT_SECURE_NO_WARNINGS
+
+
+#include "PackConfig.h"
+#include "../LogLib/Log.h"
+#include "../ThreadLib/ThreadPool.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <atomic>
+#include <new>
+
+
+struct PackHeader
+{
+    char               sign[8] = "";
+    unsigned long long size    = 0;
+    unsigned long long num     = 0;
+    unsigned long long block   = 0;
+};
+
+struct PackEntry
+{
+    unsigned long long offset = 0;
+    unsigned long long size   = 0;
+    unsigned long long raw    = 0;
+};
+
+/*------------------------------------------------------------------------------
+    Packed file is the header, the table of blocks and the blocks. Every block
+    holds whole lines of the text and is compressed on its own, so any block
+    can be read without the others.
+*///----------------------------------------------------------------------------
+
+class PackFile
+{
+    int state_;
+
+    FILE*      file_   = nullptr;
+    PackHeader header_;
+    PackEntry* blocks_ = nullptr;
+
+public:
+
+//------------------------------------------------------------------------------
+/*! @brief   Packed file constructor.
+ */
+
+    PackFile ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Packed file copy constructor (deleted).
+ *
+ *  @param   obj         Source packed file
+ */
+
+    PackFile (const PackFile& obj);
+
+    PackFile& operator = (const PackFile& obj); // deleted
+
+//------------------------------------------------------------------------------
+/*! @brief   Packed file destructor.
+ */
+
+   ~PackFile ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Open packed file and read its table of blocks.
+ *
+ *  @param   filename    Name of the packed file
+ *
+ *  @return  error code
+ */
+
+    int Open (const char* filename);
+
+//------------------------------------------------------------------------------
+/*! @brief   Close packed file.
+ */
+
+    void Close ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Get number of blocks.
+ *
+ *  @return  number of blocks
+ */
+
+    size_t getBlockNum () const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Get size of the unpacked text.
+ *
+ *  @return  size of the text
+ */
+
+    size_t getSize () const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Get size of the unpacked block.
+ *
+ *  @param   block       Block number
+ *
+ *  @return  size of the block text
+ */
+
+    size_t getBlockSize (size_t block) const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Read and unpack one block.
+ *
+ *  @param   block       Block number
+ *  @param   text        Buffer of getBlockSize(block) bytes at least
+ *
+ *  @return  error code
+ */
+
+    int ReadBlock (size_t block, char* text);
+
+//------------------------------------------------------------------------------
+/*! @brief   Read all blocks and unpack them in parallel.
+ *
+ *  @param   text        Unpacked text, allocated by calloc with size + 2 bytes
+ *  @param   size        Size of the text
+ *
+ *  @return  error code
+ */
+
+    int ReadAll (char*& text, size_t& size);
+
+//------------------------------------------------------------------------------
+};
+
+//------------------------------------------------------------------------------
+/*! @brief   Check that the file is a packed base.
+ *
+ *  @param   filename    Name of the file
+ *
+ *  @return  true if the file starts with the pack signature, else false
+ */
+
+bool IsPacked (const char* filename);
+
+//------------------------------------------------------------------------------
+/*! @brief   Split text into blocks on line ends, pack them in parallel and write.
+ *
+ *  @param   filename    Name of the packed file
+ *  @param   text        Text to pack
+ *  @param   size        Size of the text
+ *
+ *  @return  error code
+ */
+
+int PackText (const char* filename, const char* text, size_t size);
+
+//------------------------------------------------------------------------------
+/*! @brief   Get maximum size of the packed block.
+ *
+ *  @param   size        Size of the block text
+ *
+ *  @return  size of the buffer for the packed block
+ */
+
+size_t PackBound (size_t size);
+
+//------------------------------------------------------------------------------
+/*! @brief   Pack block with the LZ77 codec.
+ *
+ *  @note    Block is a sequence of literal runs each followed by a match:
+ *           token with 4 bit lengths, extra length bytes, literals, 2 byte
+ *           offset of the match. The last run has no match.
+ *
+ *  @param   src         Block text, no more than PACK_BLOCK_SIZE bytes
+ *  @param   size        Size of the block text
+ *  @param   dst         Buffer of PackBound(size) bytes
+ *
+ *  @return  size of the packed block
+ */
+
+size_t PackBlock (const char* src, size_t size, char* dst);
+
+//------------------------------------------------------------------------------
+/*! @brief   Unpack block packed by PackBlock.
+ *
+ *  @param   src         Packed block
+ *  @param   size        Size of the packed block
+ *  @param   dst         Buffer for the block text
+ *  @param   raw         Size of the block text
+ *
+ *  @return  error code
+ */
+
+int UnpackBlock (const char* src, size_t size, char* dst, size_t raw);
+
+//------------------------------------------------------------------------------
+
+#endif // PACK_H_INCLUDED
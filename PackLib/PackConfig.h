@@ -0,0 +1,91 @@
+/*------------------------------------------------------------------------------
+    * File:        PackConfig.h                                                *
+    * Description: Pack congigurations which define different constants and   *
+                   errors of the compressed base                               *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#ifndef PACK_CONFIG_H_INCLUDED
+#define PACK_CONFIG_H_INCLUDED
+
+
+#include <stdlib.h>
+#include <time.h>
+
+
+#if defined (__GNUC__) || defined (__clang__) || defined (__clang_major__)
+    #define __FUNC_NAME__   __PRETTY_FUNCTION__
+
+#elif defined (_MSC_VER)
+    #define __FUNC_NAME__   __FUNCSIG__
+
+#else
+    #define __FUNC_NAME__   __FUNCTION__
+
+#endif
+
+
+char const * const PACK_LOGNAME = "pack.log";
+char const * const PACK_SIGN    = "AKNPAK1";
+
+const size_t PACK_BLOCK_SIZE  = 1 << 16;
+const size_t PACK_MIN_MATCH   = 4;
+const size_t PACK_HASH_BITS   = 13;
+
+
+enum PackErrors
+{
+    PCK_NOT_OK = -1                                                    ,
+    PCK_OK = 0                                                         ,
+    PCK_NO_MEMORY                                                      ,
+
+    PCK_DESTRUCTED                                                     ,
+    PCK_NULL_INPUT_FILENAME                                            ,
+    PCK_FILE_NOT_OPENED                                                ,
+    PCK_WRONG_SIGN                                                     ,
+    PCK_WRONG_BLOCK_TABLE                                              ,
+    PCK_WRONG_BLOCK_NUMBER                                             ,
+    PCK_CORRUPTED_BLOCK                                                ,
+};
+
+char const * const pck_errstr[] =
+{
+    "ERROR"                                                            ,
+    "OK"                                                               ,
+    "Failed to allocate memory"                                        ,
+
+    "Packed file has already destructed"                               ,
+    "The input value of the packed filename turned out to be zero"     ,
+    "Failed to open the packed file"                                   ,
+    "File is not a packed base"                                        ,
+    "Block table of the packed file is damaged"                        ,
+    "There is no block with this number in the packed file"            ,
+    "Block of the packed file is damaged"                              ,
+};
+
+#define PCK_ASSERTOK(cond, err, ...) if (cond)                                                               \
+                                     {                                                                       \
+                                       PckPrintError(PACK_LOGNAME, __FILE__, __LINE__, __FUNC_NAME__, err); \
+                                       return __VA_ARGS__;                                                   \
+                                     } //
+
+
+//------------------------------------------------------------------------------
+/*! @brief   Prints an error wih description to the console and to the log file.
+ *
+ *  @param   logname     Name of the log file
+ *  @param   file        Name of the program file
+ *  @param   line        Number of line with an error
+ *  @param   function    Name of the function with an error
+ *  @param   err         Error code
+ */
+
+void PckPrintError (const char* logname, const char* file, int line, const char* function, int err);
+
+//------------------------------------------------------------------------------
+
+#endif // PACK_CONFIG_H_INCLUDED
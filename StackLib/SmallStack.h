@@ -0,0 +1,147 @@
+/*------------------------------------------------------------------------------
+    * File:        SmallStack.h                                                *
+    * Description: Stack with inline storage for the first elements.           *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#ifndef SMALLSTACK_H_INCLUDED
+#define SMALLSTACK_H_INCLUDED
+
+#define _CRT_SECURE_NO_WARNINGS
+
+
+#include "StackConfig.h"
+#include "../MetricLib/Metric.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <utility>
+#include <new>
+
+
+const size_t SMALL_STACK_CAPACITY = 64;
+
+
+template <typename TYPE, size_t INLINE_CAPACITY = SMALL_STACK_CAPACITY>
+class SmallStack
+{
+private:
+
+    TYPE    inline_[INLINE_CAPACITY];
+    TYPE*   data_     = inline_;
+    size_t  capacity_ = INLINE_CAPACITY;
+    size_t  size_cur_ = 0;
+    int     errCode_  = STACK_OK;
+
+public:
+
+//------------------------------------------------------------------------------
+/*! @brief   Small stack default constructor.
+ */
+
+    SmallStack ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Small stack copy constructor, if memory runs out the stack stays
+ *           empty with STACK_NO_MEMORY error code.
+ *
+ *  @param   obj         Source stack
+ */
+
+    SmallStack (const SmallStack& obj);
+
+    SmallStack& operator = (const SmallStack& obj);
+
+//------------------------------------------------------------------------------
+/*! @brief   Small stack move constructor.
+ *
+ *  @param   obj         Source stack, it becomes empty
+ */
+
+    SmallStack (SmallStack&& obj);
+
+    SmallStack& operator = (SmallStack&& obj);
+
+//------------------------------------------------------------------------------
+/*! @brief   Small stack destructor.
+ */
+
+   ~SmallStack ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Pushing a value onto the stack.
+ *
+ *  @param   value       Value to push
+ *
+ *  @return  error code
+ */
+
+    int Push (TYPE value);
+
+//------------------------------------------------------------------------------
+/*! @brief   Popping from stack.
+ *
+ *  @return  value from the stack if present, otherwise POISON
+ */
+
+    TYPE Pop ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Get size of the stack data.
+ *
+ *  @return  stack data size
+ */
+
+    size_t getSize () const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Get error code of the last copy to the stack.
+ *
+ *  @return  error code
+ */
+
+    int getErrCode () const;
+
+    TYPE& operator [] (size_t n);
+
+    const TYPE& operator [] (size_t n) const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Clean stack, heap storage is kept for the next use.
+ */
+
+    void Clean ();
+
+/*------------------------------------------------------------------------------
+                   Private functions                                           *
+*///----------------------------------------------------------------------------
+
+private:
+
+//------------------------------------------------------------------------------
+/*! @brief   Increase the stack by 2 times, moving data to the heap.
+ *
+ *  @return  error code
+ */
+
+    int Expand ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Take data of the source stack.
+ *
+ *  @param   obj         Source stack, it becomes empty
+ */
+
+    void Steal (SmallStack& obj);
+
+//------------------------------------------------------------------------------
+};
+
+#include "SmallStack.ipp"
+
+#endif // SMALLSTACK_H_INCLUDED
@@ -0,0 +1,219 @@
+/*------------------------------------------------------------------------------
+    * File:        SmallStack.ipp                                              *
+    * Description: Implementations of small stack functions.                   *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+template <typename TYPE, size_t INLINE_CAPACITY>
+SmallStack<TYPE, INLINE_CAPACITY>::SmallStack () { }
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE, size_t INLINE_CAPACITY>
+SmallStack<TYPE, INLINE_CAPACITY>::SmallStack (const SmallStack& obj)
+{
+    *this = obj;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE, size_t INLINE_CAPACITY>
+SmallStack<TYPE, INLINE_CAPACITY>& SmallStack<TYPE, INLINE_CAPACITY>::operator = (const SmallStack& obj)
+{
+    if (this == &obj) return *this;
+
+    size_cur_ = 0;
+    errCode_  = STACK_OK;
+
+    while (capacity_ < obj.size_cur_)
+    {
+        errCode_ = Expand();
+        if (errCode_) return *this;
+    }
+
+    for (size_t i = 0; i < obj.size_cur_; ++i)
+        data_[i] = obj.data_[i];
+
+    size_cur_ = obj.size_cur_;
+
+    return *this;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE, size_t INLINE_CAPACITY>
+SmallStack<TYPE, INLINE_CAPACITY>::SmallStack (SmallStack&& obj)
+{
+    Steal(obj);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE, size_t INLINE_CAPACITY>
+SmallStack<TYPE, INLINE_CAPACITY>& SmallStack<TYPE, INLINE_CAPACITY>::operator = (SmallStack&& obj)
+{
+    if (this == &obj) return *this;
+
+    if (data_ != inline_)
+    {
+        MET_FREE(MEM_STACKS, capacity_ * sizeof(TYPE));
+        delete [] data_;
+    }
+
+    data_     = inline_;
+    capacity_ = INLINE_CAPACITY;
+
+    Steal(obj);
+
+    return *this;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE, size_t INLINE_CAPACITY>
+SmallStack<TYPE, INLINE_CAPACITY>::~SmallStack ()
+{
+    if (data_ != inline_)
+    {
+        MET_FREE(MEM_STACKS, capacity_ * sizeof(TYPE));
+        delete [] data_;
+    }
+
+    data_     = nullptr;
+    capacity_ = 0;
+    size_cur_ = 0;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE, size_t INLINE_CAPACITY>
+int SmallStack<TYPE, INLINE_CAPACITY>::Push (TYPE value)
+{
+    if (size_cur_ == capacity_)
+    {
+        int err = Expand();
+        if (err) return err;
+    }
+
+    data_[size_cur_++] = value;
+
+    return STACK_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE, size_t INLINE_CAPACITY>
+TYPE SmallStack<TYPE, INLINE_CAPACITY>::Pop ()
+{
+    if (size_cur_ == 0) return POISON<TYPE>;
+
+    TYPE value = data_[--size_cur_];
+
+#ifndef NDEBUG
+    data_[size_cur_] = POISON<TYPE>;
+#endif // NDEBUG
+
+    return value;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE, size_t INLINE_CAPACITY>
+size_t SmallStack<TYPE, INLINE_CAPACITY>::getSize () const
+{
+    return size_cur_;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE, size_t INLINE_CAPACITY>
+int SmallStack<TYPE, INLINE_CAPACITY>::getErrCode () const
+{
+    return errCode_;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE, size_t INLINE_CAPACITY>
+TYPE& SmallStack<TYPE, INLINE_CAPACITY>::operator [] (size_t n)
+{
+    assert(n < size_cur_);
+
+    return data_[n];
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE, size_t INLINE_CAPACITY>
+const TYPE& SmallStack<TYPE, INLINE_CAPACITY>::operator [] (size_t n) const
+{
+    assert(n < size_cur_);
+
+    return data_[n];
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE, size_t INLINE_CAPACITY>
+void SmallStack<TYPE, INLINE_CAPACITY>::Clean ()
+{
+    size_cur_ = 0;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE, size_t INLINE_CAPACITY>
+int SmallStack<TYPE, INLINE_CAPACITY>::Expand ()
+{
+    TYPE* temp = new (std::nothrow) TYPE[capacity_ * 2];
+    if (temp == nullptr) return STACK_NO_MEMORY;
+
+    for (size_t i = 0; i < size_cur_; ++i)
+        temp[i] = std::move(data_[i]);
+
+    MET_ALLOC(MEM_STACKS, capacity_ * 2 * sizeof(TYPE));
+
+    if (data_ != inline_)
+    {
+        MET_FREE(MEM_STACKS, capacity_ * sizeof(TYPE));
+        delete [] data_;
+    }
+
+    data_      = temp;
+    capacity_ *= 2;
+
+    return STACK_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE, size_t INLINE_CAPACITY>
+void SmallStack<TYPE, INLINE_CAPACITY>::Steal (SmallStack& obj)
+{
+    assert(data_ == inline_);
+
+    if (obj.data_ == obj.inline_)
+    {
+        for (size_t i = 0; i < obj.size_cur_; ++i)
+            inline_[i] = std::move(obj.inline_[i]);
+    }
+    else
+    {
+        data_     = obj.data_;
+        capacity_ = obj.capacity_;
+
+        obj.data_     = obj.inline_;
+        obj.capacity_ = INLINE_CAPACITY;
+    }
+
+    size_cur_     = obj.size_cur_;
+    errCode_      = obj.errCode_;
+    obj.size_cur_ = 0;
+    obj.errCode_  = STACK_OK;
+}
+
+//------------------------------------------------------------------------------
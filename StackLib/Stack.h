@@ -15,6 +15,8 @@
 
 
 #include "StackConfig.h"
+#include "../LogLib/Log.h"
+#include "../MetricLib/Metric.h"
 #include <assert.h>
 #include <limits.h>
 #include <memory.h>
@@ -29,23 +31,19 @@
 #endif // HASH_PROTECT
 
 
-#define STACK_CHECK if (Check ())                                                                                      \
-                    {                                                                                                  \
-                      FILE* log = fopen(STACK_LOGNAME, "a");                                                           \
-                      assert (log != nullptr);                                                                         \
-                      fprintf(log, "ERROR: file %s  line %d  function \"%s\"\n\n", __FILE__, __LINE__, __FUNC_NAME__); \
-                      printf (     "ERROR: file %s  line %d  function \"%s\"\n",   __FILE__, __LINE__, __FUNC_NAME__); \
-                      fclose(log);                                                                                     \
-                      Dump( __FUNC_NAME__, STACK_LOGNAME);                                                             \
-                      exit(errCode_);                                                                                  \
-                    } //
+#define STACK_CHECK(...) if (Check ())                                                                                        \
+                         {                                                                                                    \
+                           printError (STACK_LOGNAME , __FILE__, __LINE__, __FUNC_NAME__, errCode_);                          \
+                           Dump( __FUNC_NAME__, STACK_LOGNAME);                                                               \
+                           return __VA_ARGS__;                                                                                \
+                         } //
 
 
-#define STACK_ASSERTOK(cond, err) if (cond)                                                              \
-                                  {                                                                      \
-                                    printError (STACK_LOGNAME , __FILE__, __LINE__, __FUNC_NAME__, err); \
-                                    exit(err);                                                           \
-                                  } //
+#define STACK_ASSERTOK(cond, err, ...) if (cond)                                                              \
+                                       {                                                                      \
+                                         printError (STACK_LOGNAME , __FILE__, __LINE__, __FUNC_NAME__, err); \
+                                         return __VA_ARGS__;                                                  \
+                                       } //
 
 const size_t DEFAULT_STACK_CAPACITY = 8;
 static int   stack_id   = 0;
@@ -65,6 +63,7 @@ private:
     char*   name_     = nullptr;
     size_t  capacity_ = 0;
     size_t  size_cur_ = 0;
+    size_t  limit_    = STACK_NO_LIMIT;
 
     TYPE* data_ = nullptr;
 
@@ -127,6 +126,16 @@ public:
 
     TYPE Pop ();
 
+//------------------------------------------------------------------------------
+/*! @brief   Reserve memory for the stack data.
+ *
+ *  @param   capacity    Number of elements to be pushed without reallocation
+ *
+ *  @return  error code
+ */
+
+    int Reserve (size_t capacity);
+
 //------------------------------------------------------------------------------
 /*! @brief   Get size of the stack data.
  *
@@ -135,6 +144,23 @@ public:
 
     size_t getSize () const;
 
+//------------------------------------------------------------------------------
+/*! @brief   Set soft limit of the stack size, Push returns STACK_LIMIT_EXCEEDED
+ *           when it is reached.
+ *
+ *  @param   limit       Maximum stack size or STACK_NO_LIMIT
+ */
+
+    void setLimit (size_t limit);
+
+//------------------------------------------------------------------------------
+/*! @brief   Get soft limit of the stack size.
+ *
+ *  @return  maximum stack size or STACK_NO_LIMIT
+ */
+
+    size_t getLimit () const;
+
 //------------------------------------------------------------------------------
 /*! @brief   Get name of the stack.
  *
@@ -162,7 +188,11 @@ public:
     void Clean ();
 
 //------------------------------------------------------------------------------
-/*! @brief   Print the contents of the stack and its data to the logfile.
+/*! @brief   Print the contents of the stack and its data to the console, or put
+ *           the record of the stack state to the log when called from a function.
+ *
+ *  @note    Record has the error level if the stack is broken, else the debug
+ *           level, so the dumps of every operation are filtered out cheaply.
  *
  *  @param   funcname    Name of the function from which the StackDump was called
  *  @param   logname     Name of the logfile
@@ -185,12 +215,14 @@ private:
     void fillPoison ();
 
 //------------------------------------------------------------------------------
-/*! @brief   Increase the stack by 2 times.
+/*! @brief   Increase the stack by 2 times or up to the capacity if it is bigger.
+ *
+ *  @param   capacity    Least new capacity
  *
  *  @return  error code
  */
 
-    int Expand ();
+    int Expand (size_t capacity = 0);
 
 //------------------------------------------------------------------------------
 /*! @brief   Check stack for problems and hash (if enabled).
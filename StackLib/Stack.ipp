@@ -22,11 +22,11 @@ Stack<TYPE>::Stack (char* stack_name, size_t capacity) :
     id_       (stack_id++),
     errCode_  (STACK_OK)
 {
-    STACK_ASSERTOK((capacity > MAX_CAPACITY),   STACK_WRONG_INPUT_CAPACITY_VALUE_BIG);
     STACK_ASSERTOK((capacity == 0),             STACK_WRONG_INPUT_CAPACITY_VALUE_NIL);
     STACK_ASSERTOK((stack_name == nullptr),     STACK_WRONG_INPUT_STACK_NAME);
     
     data_ = new TYPE[capacity_];
+    MET_ALLOC(MEM_STACKS, capacity_ * sizeof(TYPE));
 
     fillPoison();
 
@@ -35,7 +35,7 @@ Stack<TYPE>::Stack (char* stack_name, size_t capacity) :
     stackhash_ = hash(this, SizeForHash());
 #endif // HASH_PROTECT
 
-    STACK_CHECK;
+    STACK_CHECK();
 
     DUMP_PRINT{ Dump(__FUNC_NAME__); }
 }
@@ -44,15 +44,17 @@ Stack<TYPE>::Stack (char* stack_name, size_t capacity) :
 
 template <typename TYPE>
 Stack<TYPE>::Stack (const Stack& obj) :
+    name_     (obj.name_),
     size_cur_ (obj.size_cur_),
     capacity_ (obj.capacity_),
+    limit_    (obj.limit_),
     id_       (stack_id++),
     errCode_  (STACK_OK)
 {
-    STACK_ASSERTOK((capacity_ > MAX_CAPACITY),  STACK_WRONG_INPUT_CAPACITY_VALUE_BIG);
     STACK_ASSERTOK((capacity_ == 0),            STACK_WRONG_INPUT_CAPACITY_VALUE_NIL);
 
     data_ = new TYPE[capacity_];
+    MET_ALLOC(MEM_STACKS, capacity_ * sizeof(TYPE));
 
     for (int i = 0; i < capacity_; ++i) data_[i] = obj.data_[i];
 
@@ -61,7 +63,7 @@ Stack<TYPE>::Stack (const Stack& obj) :
     stackhash_ = hash(this, SizeForHash());
 #endif // HASH_PROTECT
 
-    STACK_CHECK;
+    STACK_CHECK();
 
     DUMP_PRINT{ Dump(__FUNC_NAME__); }
 }
@@ -71,24 +73,27 @@ Stack<TYPE>::Stack (const Stack& obj) :
 template <typename TYPE>
 Stack<TYPE>& Stack<TYPE>::operator = (const Stack& obj)
 {
-    STACK_ASSERTOK((obj.capacity_ > MAX_CAPACITY), STACK_WRONG_INPUT_CAPACITY_VALUE_BIG);
-    STACK_ASSERTOK((obj.capacity_ == 0),           STACK_WRONG_INPUT_CAPACITY_VALUE_NIL);
+    STACK_ASSERTOK((obj.capacity_ == 0),           STACK_WRONG_INPUT_CAPACITY_VALUE_NIL, *this);
+
+    if (data_ != nullptr) MET_FREE(MEM_STACKS, capacity_ * sizeof(TYPE));
 
     size_cur_ = obj.size_cur_;
     capacity_ = obj.capacity_;
+    limit_    = obj.limit_;
     errCode_  = STACK_OK;
 
     delete[] data_;
     data_ = new TYPE[capacity_];
+    MET_ALLOC(MEM_STACKS, capacity_ * sizeof(TYPE));
 
-    for (int i = 0; i < capacity_; ++i) copyType(data_[i], obj.data_[i]);
+    for (int i = 0; i < capacity_; ++i) data_[i] = obj.data_[i];
 
 #ifdef HASH_PROTECT
     datahash_  = hash(data_, capacity_ * sizeof(TYPE));
     stackhash_ = hash(this, SizeForHash());
 #endif // HASH_PROTECT
 
-    STACK_CHECK;
+    STACK_CHECK(*this);
 
     DUMP_PRINT{ Dump(__FUNC_NAME__); }
 
@@ -110,6 +115,8 @@ Stack<TYPE>::~Stack ()
 
         fillPoison();
 
+        if (data_ != nullptr) MET_FREE(MEM_STACKS, capacity_ * sizeof(TYPE));
+
         delete [] data_;
         data_  = nullptr;
 
@@ -133,9 +140,15 @@ Stack<TYPE>::~Stack ()
 template <typename TYPE>
 int Stack<TYPE>::Push (TYPE value)
 {
-    STACK_CHECK;
+    STACK_CHECK(errCode_);
 
-    if (size_cur_ == capacity_ - 1) Expand();
+    if ((limit_ != STACK_NO_LIMIT) && (size_cur_ >= limit_)) return STACK_LIMIT_EXCEEDED;
+
+    if (size_cur_ == capacity_ - 1)
+    {
+        int err = Expand();
+        if (err) return err;
+    }
 
     data_[size_cur_++] = value;
 
@@ -144,7 +157,7 @@ int Stack<TYPE>::Push (TYPE value)
     stackhash_ = hash(this, SizeForHash());
 #endif // HASH_PROTECT
 
-    STACK_CHECK;
+    STACK_CHECK(errCode_);
 
     DUMP_PRINT{ Dump (__FUNC_NAME__); }
 
@@ -156,7 +169,7 @@ int Stack<TYPE>::Push (TYPE value)
 template <typename TYPE>
 TYPE Stack<TYPE>::Pop ()
 {
-    STACK_CHECK;
+    STACK_CHECK();
 
     if (size_cur_ == 0) errCode_ = STACK_EMPTY_STACK;
 
@@ -181,7 +194,7 @@ TYPE Stack<TYPE>::Pop ()
     stackhash_ = hash(this, SizeForHash());
 #endif // HASH_PROTECT
 
-    STACK_CHECK;
+    STACK_CHECK();
 
     DUMP_PRINT{ Dump (__FUNC_NAME__); }
 
@@ -193,15 +206,18 @@ TYPE Stack<TYPE>::Pop ()
 template <typename TYPE>
 void Stack<TYPE>::Clean ()
 {
-    STACK_CHECK;
+    STACK_CHECK();
 
     size_cur_ = 0;
     fillPoison();
+
+    MET_FREE(MEM_STACKS, capacity_ * sizeof(TYPE));
     delete [] data_;
 
     capacity_ = DEFAULT_STACK_CAPACITY;
 
     data_ = new TYPE[capacity_];
+    MET_ALLOC(MEM_STACKS, capacity_ * sizeof(TYPE));
 
     fillPoison();
 
@@ -210,9 +226,33 @@ void Stack<TYPE>::Clean ()
     stackhash_ = hash(this, SizeForHash());
 #endif // HASH_PROTECT
 
-    STACK_CHECK;
+    STACK_CHECK();
+
+    DUMP_PRINT{ Dump (__FUNC_NAME__); }
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Stack<TYPE>::Reserve (size_t capacity)
+{
+    STACK_CHECK(errCode_);
+
+    // one more element is kept for the POISON after the top
+    if (capacity < capacity_) return STACK_OK;
+
+    int err = Expand(capacity + 1);
+
+#ifdef HASH_PROTECT
+    datahash_  = hash(data_, capacity_ * sizeof(TYPE));
+    stackhash_ = hash(this, SizeForHash());
+#endif // HASH_PROTECT
+
+    STACK_CHECK(errCode_);
 
     DUMP_PRINT{ Dump (__FUNC_NAME__); }
+
+    return err;
 }
 
 //------------------------------------------------------------------------------
@@ -225,6 +265,22 @@ size_t Stack<TYPE>::getSize () const
 
 //------------------------------------------------------------------------------
 
+template <typename TYPE>
+void Stack<TYPE>::setLimit (size_t limit)
+{
+    limit_ = limit;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+size_t Stack<TYPE>::getLimit () const
+{
+    return limit_;
+}
+
+//------------------------------------------------------------------------------
+
 template <typename TYPE>
 const char* Stack<TYPE>::getName () const
 {
@@ -244,7 +300,9 @@ void Stack<TYPE>::setName (char* name)
 template <typename TYPE>
 TYPE& Stack<TYPE>::operator [] (size_t n)
 {
-    STACK_ASSERTOK((n >= capacity_), STACK_MEM_ACCESS_VIOLATION);
+    // wrong index gets the element outside of the stack, it is always POISON
+    static TYPE outside;
+    STACK_ASSERTOK((n >= capacity_), STACK_MEM_ACCESS_VIOLATION, outside = POISON<TYPE>);
 
     return data_[n];
 }
@@ -254,7 +312,9 @@ TYPE& Stack<TYPE>::operator [] (size_t n)
 template <typename TYPE>
 const TYPE& Stack<TYPE>::operator [] (size_t n) const
 {
-    STACK_ASSERTOK((n >= capacity_), STACK_MEM_ACCESS_VIOLATION);
+    // wrong index gets the element outside of the stack, it is always POISON
+    static TYPE outside;
+    STACK_ASSERTOK((n >= capacity_), STACK_MEM_ACCESS_VIOLATION, outside = POISON<TYPE>);
     
     return data_[n];
 }
@@ -277,18 +337,26 @@ void Stack<TYPE>::fillPoison ()
 //------------------------------------------------------------------------------
 
 template <typename TYPE>
-int Stack<TYPE>::Expand ()
+int Stack<TYPE>::Expand (size_t capacity)
 {
     assert(this != nullptr);
 
-    capacity_ *= 2;
+    size_t new_capacity = capacity_ * 2;
+    if (new_capacity < capacity) new_capacity = capacity;
 
-    TYPE* temp = temp = new TYPE[capacity_];
+    if (new_capacity <= capacity_) return STACK_NO_MEMORY;
 
-    memcpy(temp, (char*)data_, capacity_ * sizeof(TYPE) / 2);
+    TYPE* temp = new (std::nothrow) TYPE[new_capacity];
+    if (temp == nullptr) return STACK_NO_MEMORY;
+
+    memcpy(temp, (char*)data_, capacity_ * sizeof(TYPE));
+
+    MET_ALLOC(MEM_STACKS, new_capacity * sizeof(TYPE));
+    MET_FREE (MEM_STACKS, capacity_    * sizeof(TYPE));
 
     delete [] data_;
-    data_ = temp;
+    data_     = temp;
+    capacity_ = new_capacity;
 
     fillPoison();
 
@@ -303,38 +371,29 @@ int Stack<TYPE>::Dump (const char* funcname, const char* logfile)
     const size_t linelen = 80;
     char divline[linelen + 1] = "********************************************************************************";
 
-    FILE* fp = stdout;
     if (funcname != nullptr)
     {
-        fp = fopen(logfile, "a");
-        if (fp == nullptr)
-            return STACK_NOT_OK;
-
-        if (funcname != nullptr)
-            fprintf(fp, "This dump was called from a function \"%s\"\n", funcname);
-
-        time_t t = time(NULL);
-        struct tm tm = *localtime(&t);
-        fprintf(fp, "TIME: %d-%02d-%02d %02d:%02d:%02d\n\n",
-                tm.tm_year + 1900,
-                tm.tm_mon + 1,
-                tm.tm_mday,
-                tm.tm_hour,
-                tm.tm_min,
-                tm.tm_sec);
+        int level = (errCode_ == STACK_OK) ? LOG_DEBUG : LOG_ERROR;
+        if (not LogEnabled(level)) return STACK_OK;
+
+        int err = LogWrite(level, logfile, "lib=stack func=\"%s\" stack=\"%s\" id=%d state=\"%s\" capacity=%lu size=%lu limit=%lu",
+                           funcname, (name_ != nullptr) ? name_ : "", id_, stk_errstr[errCode_ + 1], capacity_, size_cur_, limit_);
+
+        return (err == LOG_OK) ? STACK_OK : STACK_NOT_OK;
     }
 
+    FILE* fp = stdout;
+
     if ((errCode_ == STACK_NOT_CONSTRUCTED)      ||
         (errCode_ == STACK_DESTRUCTED)           ||
         (errCode_ == STACK_NULL_DATA_PTR)        ||
         (errCode_ == STACK_SIZE_BIGGER_CAPACITY) ||
         (errCode_ == STACK_CAPACITY_WRONG_VALUE)   )
     {
-        fprintf(fp, "\nStack (ERROR) [" PRINT_PTR "] \"%s\" id (%d)\n", this, name_, id_);
+        fprintf(fp, "\nStack (ERROR) [" PRINT_PTR "] \"%s\" id (%d)\n", this, (name_ != nullptr) ? name_ : "", id_);
         ErrorPrint(fp);
 
         fprintf(fp, "%s\n", divline);
-        if (fp != stdout) fclose(fp);
 
         return STACK_OK;
     }
@@ -343,14 +402,15 @@ int Stack<TYPE>::Dump (const char* funcname, const char* logfile)
 
     if (errCode_) ErrorPrint(fp);
 
-    fprintf(fp, "\nStack (%s) [" PRINT_PTR "] \"%s\", id (%d)\n", StkState, this, name_, id_);
+    fprintf(fp, "\nStack (%s) [" PRINT_PTR "] \"%s\", id (%d)\n", StkState, this, (name_ != nullptr) ? name_ : "", id_);
 
     fprintf(fp, "\t{\n");
 
     fprintf(fp, "\tType of data is %s\n\n", PRINT_TYPE<TYPE>);
 
     fprintf(fp, "\tCapacity           = %lu\n",   capacity_);
-    fprintf(fp, "\tCurrent size       = %lu\n\n", size_cur_);
+    fprintf(fp, "\tCurrent size       = %lu\n",   size_cur_);
+    fprintf(fp, "\tSize limit         = %lu\n\n", limit_);
 
 #ifdef HASH_PROTECT
     fprintf(fp, "\tStack hash         = " HASH_PRINT_FORMAT "\n",   stackhash_);
@@ -381,7 +441,6 @@ int Stack<TYPE>::Dump (const char* funcname, const char* logfile)
     fprintf(fp, "\t}\n");
 
     fprintf(fp, "%s\n", divline);
-    if (fp != stdout) fclose(fp);
 
     return STACK_OK;
 }
@@ -423,7 +482,7 @@ int Stack<TYPE>::Check ()
         errCode_ = STACK_SIZE_BIGGER_CAPACITY;
     }
 
-    else if ((capacity_ == 0) || (capacity_ > MAX_CAPACITY))
+    else if (capacity_ == 0)
     {
         errCode_ = STACK_CAPACITY_WRONG_VALUE;
     }
@@ -476,28 +535,10 @@ static void printError (const char* logname, const char* file, int line, const c
     assert(logname  != nullptr);
     assert(file     != nullptr);
 
-    FILE* log = fopen(logname, "a");
-    assert(log != nullptr);
-
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    fprintf(log, "TIME: %d-%02d-%02d %02d:%02d:%02d\n\n",
-            tm.tm_year + 1900,
-            tm.tm_mon + 1,
-            tm.tm_mday,
-            tm.tm_hour,
-            tm.tm_min,
-            tm.tm_sec);
-
-    fprintf(log, "ERROR: file %s  line %d  function %s\n\n", file, line, function);
-    fprintf(log, "%s\n", stk_errstr[err + 1]);
+    LogError(logname, "stack", file, line, function, err, stk_errstr[err + 1]);
 
     printf("ERROR: file %s  line %d  function %s\n", file, line, function);
     printf("%s\n\n", stk_errstr[err + 1]);
-
-    fprintf(log, "********************************************************************************\n");
-
-    fclose(log);
 }
 
 //------------------------------------------------------------------------------
@@ -53,7 +53,7 @@
 
 char const * const STACK_LOGNAME = "stack.log";
 
-constexpr size_t MAX_CAPACITY  = 100000;
+constexpr size_t STACK_NO_LIMIT = 0;
 
 
 enum StackErrors
@@ -67,6 +67,7 @@ enum StackErrors
     STACK_DESTRUCTOR_REPEATED                                       ,
     STACK_EMPTY_STACK                                               ,
     STACK_INCORRECT_HASH                                            ,
+    STACK_LIMIT_EXCEEDED                                            ,
     STACK_MEM_ACCESS_VIOLATION                                      ,
     STACK_NOT_CONSTRUCTED                                           ,
     STACK_NULL_DATA_PTR                                             ,
@@ -74,7 +75,6 @@ enum StackErrors
     STACK_NULL_STACK_PTR                                            ,
     STACK_SIZE_BIGGER_CAPACITY                                      ,
     STACK_WRONG_CUR_SIZE                                            ,
-    STACK_WRONG_INPUT_CAPACITY_VALUE_BIG                            ,
     STACK_WRONG_INPUT_CAPACITY_VALUE_NIL                            ,
     STACK_WRONG_INPUT_STACK_NAME                                    ,
 };
@@ -90,6 +90,7 @@ char const * const stk_errstr[] =
     "Stack destructor repeated"                                     ,
     "Stack is empty"                                                ,
     "Stack cracked, hash corrupted"                                 ,
+    "Stack size limit exceeded"                                     ,
     "Memory access violation"                                       ,
     "Stack did not constructed, operation is impossible"            ,
     "The pointer to the stack is null, data lost"                   ,
@@ -97,7 +98,6 @@ char const * const stk_errstr[] =
     "The pointer to the stack is null, stack lost"                  ,
     "The size of the stack data is larger than the capacity"        ,
     "Current size of stack data is wrong"                           ,
-    "Wrong capacity value: - is too big"                            ,
     "Wrong capacity value: - is nil"                                ,
     "Wrong input stack name"                                        ,
 };
@@ -26,22 +26,46 @@ Text::Text (const char* filename) :
     {
         printf("\n ERROR. Input file \"%s\" is not found\n", filename);
 
+        state_ = STR_FILE_NOT_OPENED;
         return;
     }
 
     size_ = CountSize(fp);
-    STR_ASSERTOK((size_ == 0), STR_NO_SYMB);
+    if (size_ != 0)
+        text_ = GetText(fp, size_);
+
+    fclose(fp);
 
-    text_ = GetText(fp, size_);
+    STR_ASSERTOK((size_ == 0), STR_NO_SYMB);
     STR_ASSERTOK((text_ == nullptr), STR_NO_MEMORY);
+    MET_ALLOC(MEM_TEXTS, size_ + 2);
 
     num_ = GetLineNum(text_, size_);
     STR_ASSERTOK((num_ == 0), STR_NO_LINES);
 
     lines_ = GetLine(text_, num_);
     STR_ASSERTOK((lines_ == nullptr), STR_NO_MEMORY);
+    MET_ALLOC(MEM_TEXTS, (num_ + 2) * sizeof(Line));
+}
 
-    fclose(fp);
+//------------------------------------------------------------------------------
+
+Text::Text (char* text, size_t size) :
+    state_ (STR_OK)
+{
+    STR_ASSERTOK((text == nullptr), STR_NULL_INPUT_TEXT_PTR);
+    STR_ASSERTOK((size == 0), STR_NO_SYMB);
+
+    text_ = text;
+    size_ = size;
+    MET_ALLOC(MEM_TEXTS, size_ + 2);
+
+    num_ = GetLineNum(text_, size_);
+    STR_ASSERTOK((num_ == 0), STR_NO_LINES);
+
+    lines_ = GetLine(text_, num_);
+    STR_ASSERTOK((lines_ == nullptr), STR_NO_MEMORY);
+    MET_ALLOC(MEM_TEXTS, (num_ + 2) * sizeof(Line));
 }
 
 //------------------------------------------------------------------------------
@@ -55,6 +79,7 @@ Text::Text (size_t lines_num, size_t line_len) :
     num_ = lines_num;
     lines_ = (Line*)calloc(num_ + 2, sizeof(Line));
     STR_ASSERTOK((lines_ == nullptr) , STR_NO_MEMORY);
+    MET_ALLOC(MEM_TEXTS, (num_ + 2) * sizeof(Line));
 
     for (int i = 0; i < num_; ++i)
     {
@@ -72,21 +97,17 @@ Text::~Text ()
 
     if ((state_ != STR_TEXT_DESTRUCTED) && (state_ != STR_TEXT_NOT_CONSTRUCTED))
     {
-        if (num_ != 0)
-        {
-            assert(lines_ != nullptr);
-            free(lines_);
-            lines_ = nullptr;
-            num_   = 0;
-        }
+        // constructor may stop on an error, so only allocated parts are freed
+        if (lines_ != nullptr) MET_FREE(MEM_TEXTS, (num_ + 2) * sizeof(Line));
+        if (text_  != nullptr) MET_FREE(MEM_TEXTS, size_ + 2);
 
-        if (size_ != 0)
-        {
-            assert(text_ != nullptr);
-            free(text_);
-            text_ = nullptr;
-            size_ = 0;
-        }
+        free(lines_);
+        lines_ = nullptr;
+        num_   = 0;
+
+        free(text_);
+        text_ = nullptr;
+        size_ = 0;
 
         state_ = STR_TEXT_DESTRUCTED;
     }
@@ -96,8 +117,8 @@ Text::~Text ()
 
 int Text::Expand (size_t line_len)
 {
-    STR_ASSERTOK((this == nullptr), STR_NULL_INPUT_TEXT_PTR);
-    STR_ASSERTOK(state_, state_);
+    STR_ASSERTOK((this == nullptr), STR_NULL_INPUT_TEXT_PTR, STR_NULL_INPUT_TEXT_PTR);
+    STR_ASSERTOK(state_, state_, state_);
 
     num_ *= 2;
 
@@ -110,13 +131,16 @@ int Text::Expand (size_t line_len)
     memcpy(temp, lines_, num_ * sizeof(Line) / 2);
     free(oldtemp);
 
+    MET_ALLOC(MEM_TEXTS, (num_ + 2) * sizeof(Line));
+    MET_FREE (MEM_TEXTS, (num_ / 2 + 2) * sizeof(Line));
+
     lines_ = (Line*)temp;
 
     for (int i = num_ / 2; i < num_; ++i)
     {
         lines_[i].len = line_len;
         lines_[i].str = (char*)calloc(line_len, 1);
-        STR_ASSERTOK((lines_[i].str == nullptr) , STR_NO_MEMORY);
+        STR_ASSERTOK((lines_[i].str == nullptr) , STR_NO_MEMORY, STR_NO_MEMORY);
     }
 
     return STR_OK;
@@ -154,17 +178,19 @@ BinCode::BinCode (const char* filename) :
     {
         printf("\n ERROR. Input file \"%s\" is not found\n", filename);
 
+        state_ = STR_FILE_NOT_OPENED;
         return;
     }
 
     size_ = CountSize(fp);
-    STR_ASSERTOK((size_ == 0) , STR_NO_MEMORY);
-
-    data_ = GetText(fp, size_);
-    STR_ASSERTOK((data_ == nullptr) , STR_NO_MEMORY);
+    if (size_ != 0)
+        data_ = GetText(fp, size_);
 
     fclose(fp);
 
+    STR_ASSERTOK((size_ == 0) , STR_NO_MEMORY);
+    STR_ASSERTOK((data_ == nullptr) , STR_NO_MEMORY);
+
     ptr_ = 0;
 }
 
@@ -191,8 +217,8 @@ BinCode::~BinCode ()
 
 int BinCode::Expand ()
 {
-    STR_ASSERTOK((this == nullptr), STR_NULL_INPUT_BINCODE_PTR);
-    STR_ASSERTOK(state_, state_);
+    STR_ASSERTOK((this == nullptr), STR_NULL_INPUT_BINCODE_PTR, STR_NULL_INPUT_BINCODE_PTR);
+    STR_ASSERTOK(state_, state_, state_);
 
     size_ *= 2;
 
@@ -549,22 +575,10 @@ void StrPrintError (const char* logname, const char* file, int line, const char*
     assert(logname != nullptr);
     assert(file != nullptr);
 
-    FILE* log = fopen(logname, "a");
-    assert(log != nullptr);
-
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-
-    fprintf(log, "###############################################################################\n");
-    fprintf(log, "TIME: %d-%02d-%02d %02d:%02d:%02d\n\n",
-            tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
-    fprintf(log, "ERROR: file %s  line %d  function %s\n\n", file, line, function);
-    fprintf(log, "%s\n", str_errstr[err + 1]);
+    LogError(logname, "string", file, line, function, err, str_errstr[err + 1]);
 
     printf (     "ERROR: file %s  line %d  function %s\n",   file, line, function);
     printf (     "%s\n\n", str_errstr[err + 1]);
-
-    fclose(log);
 }
 
 //------------------------------------------------------------------------------
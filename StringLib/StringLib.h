@@ -14,6 +14,8 @@
 #define _CRT_SECURE_NO_WARNINGS
 
 
+#include "../LogLib/Log.h"
+#include "../MetricLib/Metric.h"
 #include <sys/stat.h>
 #include <assert.h>
 #include <stdlib.h>
@@ -64,6 +66,7 @@ enum StringErrors
     STR_BINCODE_NOT_CONSTRUCTED                                        ,
     STR_TEXT_DESTRUCTED                                                ,
     STR_TEXT_NOT_CONSTRUCTED                                           ,
+    STR_FILE_NOT_OPENED                                                ,
 };
 
 char const * const str_errstr[] =
@@ -85,15 +88,17 @@ char const * const str_errstr[] =
     "BinCode did not constructed, operation is impossible"             ,
     "Text has already destructed"                                      ,
     "Text did not constructed, operation is impossible"                ,
+    "Failed to open the input file"                                    ,
 };
 
 char const * const STRING_LOGNAME = "string.log";
 
-#define STR_ASSERTOK(cond, err)  if (cond)                                                                \
-                                 {                                                                        \
-                                   StrPrintError(STRING_LOGNAME, __FILE__, __LINE__, __FUNC_NAME__, err); \
-                                   exit(err);                                                             \
-                                 } //
+#define STR_ASSERTOK(cond, err, ...)  if (cond)                                                                \
+                                      {                                                                        \
+                                        StrPrintError(STRING_LOGNAME, __FILE__, __LINE__, __FUNC_NAME__, err); \
+                                        state_ = err;                                                          \
+                                        return __VA_ARGS__;                                                    \
+                                      } //
 
 
 //==============================================================================
@@ -144,6 +149,18 @@ public:
 
     Text (size_t lines_num, size_t line_len);
 
+//------------------------------------------------------------------------------
+/*! @brief   Text constructor from memory.
+ *
+ *  @note    Text takes the buffer, it must be allocated by calloc with
+ *           size + 2 bytes so that the text is null terminated.
+ *
+ *  @param   text        Pointer to the text buffer
+ *  @param   size        Size of the text
+ */
+
+    Text (char* text, size_t size);
+
 //------------------------------------------------------------------------------
 /*! @brief   Text copy constructor (deleted).
  *
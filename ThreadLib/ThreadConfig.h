@@ -0,0 +1,54 @@
+/*------------------------------------------------------------------------------
+    * File:        ThreadConfig.h                                              *
+    * Description: Thread pool congigurations which define constants and      *
+                   errors of the task scheduler                                *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#ifndef THREAD_CONFIG_H_INCLUDED
+#define THREAD_CONFIG_H_INCLUDED
+
+
+#include <stdlib.h>
+
+
+const size_t POOL_MAX_THREADS = 16;
+const size_t POOL_QUEUE_SIZE  = 1 << 10; // power of two
+
+#ifdef  NO_THREADS
+
+    #define POOL_DEFAULT_THREADS 1 // every task is run by the thread which submits it
+
+#else
+
+    #define POOL_DEFAULT_THREADS 0 // one thread for every core
+
+#endif // NO_THREADS
+
+
+enum PoolErrors
+{
+    POOL_NOT_OK = -1                                                   ,
+    POOL_OK = 0                                                        ,
+    POOL_NO_MEMORY                                                     ,
+
+    POOL_BUSY                                                          ,
+    POOL_DESTRUCTED                                                    ,
+};
+
+char const * const pool_errstr[] =
+{
+    "ERROR"                                                            ,
+    "OK"                                                               ,
+    "Failed to allocate memory"                                        ,
+
+    "Thread pool has tasks, it can not be resized"                     ,
+    "Thread pool has already destructed"                               ,
+};
+
+
+#endif // THREAD_CONFIG_H_INCLUDED
@@ -0,0 +1,267 @@
+/*------------------------------------------------------------------------------
+    * File:        ThreadPool.cpp                                              *
+    * Description: Functions for the work-stealing task scheduler.             *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#include "ThreadPool.h"
+
+//------------------------------------------------------------------------------
+
+static thread_local const ThreadPool* pool_owner  = nullptr;
+static thread_local size_t            pool_worker = 0;
+
+//------------------------------------------------------------------------------
+
+TaskGroup::TaskGroup () :
+    pending_ (0)
+{}
+
+//------------------------------------------------------------------------------
+
+ThreadPool::ThreadPool (size_t threads_num) :
+    state_   (POOL_OK),
+    running_ (false),
+    queued_  (0)
+{
+    state_ = Start(threads_num);
+}
+
+//------------------------------------------------------------------------------
+
+ThreadPool::~ThreadPool ()
+{
+    if (state_ == POOL_DESTRUCTED) return;
+
+    Stop();
+
+    state_ = POOL_DESTRUCTED;
+}
+
+//------------------------------------------------------------------------------
+
+int ThreadPool::Resize (size_t threads_num)
+{
+    if (state_ == POOL_DESTRUCTED)                        return POOL_DESTRUCTED;
+    if (queued_.load(std::memory_order_acquire) != 0)     return POOL_BUSY;
+
+    Stop();
+    state_ = Start(threads_num);
+
+    return state_;
+}
+
+//------------------------------------------------------------------------------
+
+size_t ThreadPool::getThreadsNum () const
+{
+    return threads_num_;
+}
+
+//------------------------------------------------------------------------------
+
+void ThreadPool::Wait (TaskGroup& group)
+{
+    while (group.pending_.load(std::memory_order_acquire) != 0)
+    {
+        if (RunOne()) continue;
+
+        // the last tasks of the group are run by other threads
+        std::unique_lock<std::mutex> lock(idle_mutex_);
+        idle_.wait(lock, [this, &group] ()
+        {
+            return (group.pending_.load(std::memory_order_acquire) == 0) || (queued_.load(std::memory_order_acquire) != 0);
+        });
+    }
+}
+
+//------------------------------------------------------------------------------
+
+int ThreadPool::Start (size_t threads_num)
+{
+    if (threads_num == 0) threads_num = std::thread::hardware_concurrency();
+    if (threads_num == 0) threads_num = 1;
+    if (threads_num > POOL_MAX_THREADS) threads_num = POOL_MAX_THREADS;
+
+    threads_num_ = 1;
+    if (threads_num == 1) return POOL_OK;
+
+    // the last queue is shared by the threads which are not workers
+    queues_ = new (std::nothrow) WorkQueue [threads_num];
+    if (queues_ == nullptr) return POOL_NO_MEMORY;
+
+    // Stop frees the queues allocated so far if the start fails
+    threads_num_ = threads_num;
+
+    for (size_t i = 0; i < threads_num; ++i)
+    {
+        queues_[i].tasks = new (std::nothrow) PoolTask [POOL_QUEUE_SIZE];
+        if (queues_[i].tasks == nullptr)
+        {
+            Stop();
+            return POOL_NO_MEMORY;
+        }
+    }
+
+    threads_ = new (std::nothrow) std::thread [threads_num - 1];
+    if (threads_ == nullptr)
+    {
+        Stop();
+        return POOL_NO_MEMORY;
+    }
+
+    running_.store(true, std::memory_order_release);
+
+    for (size_t i = 0; i < threads_num_ - 1; ++i)
+        threads_[i] = std::thread(&ThreadPool::Worker, this, i);
+
+    return POOL_OK;
+}
+
+//------------------------------------------------------------------------------
+
+void ThreadPool::Stop ()
+{
+    running_.store(false, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        idle_.notify_all();
+    }
+
+    if (threads_ != nullptr)
+    {
+        for (size_t i = 0; i < threads_num_ - 1; ++i)
+            if (threads_[i].joinable()) threads_[i].join();
+
+        delete [] threads_;
+        threads_ = nullptr;
+    }
+
+    if (queues_ != nullptr)
+    {
+        for (size_t i = 0; i < threads_num_; ++i)
+            delete [] queues_[i].tasks;
+
+        delete [] queues_;
+        queues_ = nullptr;
+    }
+
+    threads_num_ = 1;
+}
+
+//------------------------------------------------------------------------------
+
+bool ThreadPool::Push (PoolTask& task)
+{
+    WorkQueue& queue = queues_[selfQueue()];
+
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tail - queue.head == POOL_QUEUE_SIZE) return false;
+
+        queue.tasks[queue.tail & (POOL_QUEUE_SIZE - 1)] = std::move(task);
+        ++queue.tail;
+    }
+
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    queued_.fetch_add(1, std::memory_order_release);
+    idle_.notify_one();
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+bool ThreadPool::RunOne ()
+{
+    if (queued_.load(std::memory_order_acquire) == 0) return false;
+
+    size_t   self  = selfQueue();
+    PoolTask task;
+    bool     found = false;
+
+    for (size_t i = 0; (i < threads_num_) && (not found); ++i)
+    {
+        WorkQueue& queue = queues_[(self + i) % threads_num_];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tail == queue.head) continue;
+
+        if (i == 0)
+        {
+            --queue.tail;
+            task = std::move(queue.tasks[queue.tail & (POOL_QUEUE_SIZE - 1)]);
+        }
+        else
+        {
+            task = std::move(queue.tasks[queue.head & (POOL_QUEUE_SIZE - 1)]);
+            ++queue.head;
+        }
+
+        found = true;
+    }
+
+    if (not found) return false;
+
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+
+    task.func();
+    Done(*task.group);
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+void ThreadPool::Done (TaskGroup& group)
+{
+    if (group.pending_.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    // the group may be destroyed by its waiter now, only the pool is used
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    idle_.notify_all();
+}
+
+//------------------------------------------------------------------------------
+
+void ThreadPool::Worker (size_t id)
+{
+    pool_owner  = this;
+    pool_worker = id;
+
+    while (running_.load(std::memory_order_acquire))
+    {
+        if (RunOne()) continue;
+
+        std::unique_lock<std::mutex> lock(idle_mutex_);
+        idle_.wait(lock, [this] ()
+        {
+            return (queued_.load(std::memory_order_acquire) != 0) || (not running_.load(std::memory_order_acquire));
+        });
+    }
+
+    pool_owner = nullptr;
+}
+
+//------------------------------------------------------------------------------
+
+size_t ThreadPool::selfQueue () const
+{
+    return (pool_owner == this) ? pool_worker : threads_num_ - 1;
+}
+
+//------------------------------------------------------------------------------
+
+ThreadPool& GetThreadPool ()
+{
+    static ThreadPool pool;
+
+    return pool;
+}
+
+//------------------------------------------------------------------------------
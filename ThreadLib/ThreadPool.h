@@ -0,0 +1,308 @@
+/*------------------------------------------------------------------------------
+    * File:        ThreadPool.h                                                *
+    * Description: Declaration of functions and data types used for the        *
+                   work-stealing task scheduler.                               *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#ifndef THREAD_POOL_H_INCLUDED
+#define THREAD_POOL_H_INCLUDED
+
+#define _CRT_SECURE_NO_WARNINGS
+
+
+#include "ThreadConfig.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <new>
+
+
+class ThreadPool;
+
+/*------------------------------------------------------------------------------
+    Group counts its tasks which are not finished yet, ThreadPool::Wait
+    returns when all tasks submitted to the group are done.
+*///----------------------------------------------------------------------------
+
+class TaskGroup
+{
+    friend class ThreadPool;
+
+    std::atomic<size_t> pending_;
+
+public:
+
+//------------------------------------------------------------------------------
+/*! @brief   Task group constructor.
+ */
+
+    TaskGroup ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Task group copy constructor (deleted).
+ *
+ *  @param   obj         Source group
+ */
+
+    TaskGroup (const TaskGroup& obj);
+
+    TaskGroup& operator = (const TaskGroup& obj); // deleted
+
+//------------------------------------------------------------------------------
+};
+
+struct PoolTask
+{
+    std::function<void()> func;
+    TaskGroup*            group = nullptr;
+};
+
+struct alignas(64) WorkQueue
+{
+    std::mutex mutex;
+
+    PoolTask* tasks = nullptr;
+    size_t    head  = 0; // oldest task, it is stolen by other threads
+    size_t    tail  = 0; // newest task, it is taken by the owner
+};
+
+/*------------------------------------------------------------------------------
+    ThreadPool runs tasks by a fixed number of threads. Every worker has its
+    own queue: it submits and takes the newest tasks at the tail, so recursive
+    tasks of a subtree stay on one core, and idle workers steal the oldest
+    ones, which are the biggest subtrees, at the head. Threads which are not
+    workers share one more queue. A thread waiting for its group runs tasks
+    too, so tasks may submit and wait for subtasks without deadlocks. With
+    one thread or a full queue the task is run by the thread submitting it.
+    Idle workers and waiting threads with nothing to steal sleep until a task
+    is queued or a group is done, the counter is changed under the mutex of
+    the condition, so no wakeup is lost.
+*///----------------------------------------------------------------------------
+
+class ThreadPool
+{
+    int state_;
+
+    size_t threads_num_ = 1;
+
+    WorkQueue*   queues_  = nullptr;
+    std::thread* threads_ = nullptr;
+
+    std::atomic<bool>   running_;
+    std::atomic<size_t> queued_;
+
+    std::mutex              idle_mutex_;
+    std::condition_variable idle_;
+
+public:
+
+//------------------------------------------------------------------------------
+/*! @brief   Thread pool constructor, starts the workers.
+ *
+ *  @param   threads_num Number of threads which run the tasks including the
+ *                       waiting one, 0 for one thread for every core
+ */
+
+    explicit ThreadPool (size_t threads_num = POOL_DEFAULT_THREADS);
+
+//------------------------------------------------------------------------------
+/*! @brief   Thread pool copy constructor (deleted).
+ *
+ *  @param   obj         Source pool
+ */
+
+    ThreadPool (const ThreadPool& obj);
+
+    ThreadPool& operator = (const ThreadPool& obj); // deleted
+
+//------------------------------------------------------------------------------
+/*! @brief   Thread pool destructor, stops the workers.
+ */
+
+   ~ThreadPool ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Change number of threads, the pool must have no tasks.
+ *
+ *  @param   threads_num Number of threads which run the tasks including the
+ *                       waiting one, 0 for one thread for every core
+ *
+ *  @return  error code
+ */
+
+    int Resize (size_t threads_num);
+
+//------------------------------------------------------------------------------
+/*! @brief   Get number of threads which run the tasks.
+ *
+ *  @return  number of threads, 1 if tasks are run serially
+ */
+
+    size_t getThreadsNum () const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Submit the task to the group.
+ *
+ *  @param   group       Group of the task
+ *  @param   func        Task
+ */
+
+    template <typename FUNC>
+    void Submit (TaskGroup& group, FUNC func);
+
+//------------------------------------------------------------------------------
+/*! @brief   Run tasks until all tasks of the group are done.
+ *
+ *  @param   group       Group of the tasks
+ */
+
+    void Wait (TaskGroup& group);
+
+//------------------------------------------------------------------------------
+/*! @brief   Call the function for all numbers from 0 to num - 1 by all threads.
+ *
+ *  @param   num         Number of calls
+ *  @param   func        Function of the number
+ */
+
+    template <typename FUNC>
+    void ParallelFor (size_t num, FUNC func);
+
+//------------------------------------------------------------------------------
+
+private:
+
+//------------------------------------------------------------------------------
+/*! @brief   Allocate the queues and start the workers.
+ *
+ *  @param   threads_num Number of threads, 0 for one thread for every core
+ *
+ *  @return  error code
+ */
+
+    int Start (size_t threads_num);
+
+//------------------------------------------------------------------------------
+/*! @brief   Stop the workers and free the queues.
+ */
+
+    void Stop ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Put the task to the tail of the queue of the current thread.
+ *
+ *  @param   task        Task
+ *
+ *  @return  true if the task is put, false if the queue is full
+ */
+
+    bool Push (PoolTask& task);
+
+//------------------------------------------------------------------------------
+/*! @brief   Take the newest own task or steal the oldest task of other thread and run it.
+ *
+ *  @return  true if a task is run, else false
+ */
+
+    bool RunOne ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Count the task of the group as done, threads waiting for the group
+ *           are woken when its last task is done.
+ *
+ *  @param   group       Group of the task
+ */
+
+    void Done (TaskGroup& group);
+
+//------------------------------------------------------------------------------
+/*! @brief   Loop of the worker.
+ *
+ *  @param   id          Number of the worker queue
+ */
+
+    void Worker (size_t id);
+
+//------------------------------------------------------------------------------
+/*! @brief   Get queue of the current thread.
+ *
+ *  @return  number of the queue
+ */
+
+    size_t selfQueue () const;
+
+//------------------------------------------------------------------------------
+};
+
+//------------------------------------------------------------------------------
+/*! @brief   Get thread pool of the program, it is created at the first call.
+ *
+ *  @return  thread pool
+ */
+
+ThreadPool& GetThreadPool ();
+
+//------------------------------------------------------------------------------
+
+template <typename FUNC>
+void ThreadPool::Submit (TaskGroup& group, FUNC func)
+{
+    if ((threads_num_ <= 1) || (state_ != POOL_OK))
+    {
+        func();
+        return;
+    }
+
+    PoolTask task;
+    task.func  = std::move(func);
+    task.group = &group;
+
+    group.pending_.fetch_add(1, std::memory_order_relaxed);
+
+    if (not Push(task))
+    {
+        task.func();
+        Done(group);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+template <typename FUNC>
+void ThreadPool::ParallelFor (size_t num, FUNC func)
+{
+    size_t tasks_num = (threads_num_ < num) ? threads_num_ : num;
+
+    if ((tasks_num <= 1) || (state_ != POOL_OK))
+    {
+        for (size_t i = 0; i < num; ++i) func(i);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+
+    auto worker = [&next, &func, num] ()
+    {
+        for (size_t i = next++; i < num; i = next++) func(i);
+    };
+
+    TaskGroup group;
+    for (size_t i = 0; i < tasks_num - 1; ++i)
+        Submit(group, worker);
+
+    worker();
+    Wait(group);
+}
+
+//------------------------------------------------------------------------------
+
+#endif // THREAD_POOL_H_INCLUDED
@@ -0,0 +1,94 @@
+/*------------------------------------------------------------------------------
+    * File:        Path.h                                                      *
+    * Description: Declaration of the path from the tree root to a node.       *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#ifndef PATH_H_INCLUDED
+#define PATH_H_INCLUDED
+
+#define _CRT_SECURE_NO_WARNINGS
+
+
+#include "../StackLib/SmallStack.h"
+#include <assert.h>
+#include <stdlib.h>
+
+
+class Path
+{
+    SmallStack<size_t>                                   ids_;
+    SmallStack<unsigned char, SMALL_STACK_CAPACITY / 8> dirs_;
+
+public:
+
+//------------------------------------------------------------------------------
+/*! @brief   Add node to the end of the path.
+ *
+ *  @param   id          Preorder id of the node
+ *  @param   dir         Direction from the previous node (true - yes, false - no),
+ *                       ignored for the first node
+ *
+ *  @return  error code
+ */
+
+    int Push (size_t id, bool dir);
+
+//------------------------------------------------------------------------------
+/*! @brief   Remove the last node from the path.
+ */
+
+    void Pop ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Clean path.
+ */
+
+    void Clean ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Get number of nodes in the path.
+ *
+ *  @return  number of nodes
+ */
+
+    size_t getSize () const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Get preorder id of the path item.
+ *
+ *  @param   item        Path item number
+ *
+ *  @return  node id
+ */
+
+    size_t getId (size_t item) const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Get direction from the path item to the next one.
+ *
+ *  @param   item        Path item number
+ *
+ *  @return  true if the next node is the yes-child, false if the no-child
+ */
+
+    bool getDir (size_t item) const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Get packed directions, bit i of the byte i / 8 is getDir(i).
+ *
+ *  @return  pointer to (getSize() + 6) / 8 bytes of directions
+ */
+
+    const unsigned char* getDirs () const;
+
+//------------------------------------------------------------------------------
+};
+
+#include "Path.ipp"
+
+#endif // PATH_H_INCLUDED
@@ -0,0 +1,86 @@
+/*------------------------------------------------------------------------------
+    * File:        Path.ipp                                                    *
+    * Description: Functions for the path from the tree root to a node.        *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+inline int Path::Push (size_t id, bool dir)
+{
+    size_t size = ids_.getSize();
+
+    if (size != 0)
+    {
+        size_t step = size - 1;
+
+        if (step % 8 == 0)
+        {
+            int err = dirs_.Push(0);
+            if (err) return err;
+        }
+
+        if (dir) dirs_[step / 8] |= (unsigned char)(1 << (step % 8));
+    }
+
+    return ids_.Push(id);
+}
+
+//------------------------------------------------------------------------------
+
+inline void Path::Pop ()
+{
+    size_t size = ids_.getSize();
+    if (size == 0) return;
+
+    ids_.Pop();
+
+    if (size == 1) return;
+
+    size_t step = size - 2;
+
+    dirs_[step / 8] &= (unsigned char)~(1 << (step % 8));
+    if (step % 8 == 0) dirs_.Pop();
+}
+
+//------------------------------------------------------------------------------
+
+inline void Path::Clean ()
+{
+    ids_ .Clean();
+    dirs_.Clean();
+}
+
+//------------------------------------------------------------------------------
+
+inline size_t Path::getSize () const
+{
+    return ids_.getSize();
+}
+
+//------------------------------------------------------------------------------
+
+inline size_t Path::getId (size_t item) const
+{
+    return ids_[item];
+}
+
+//------------------------------------------------------------------------------
+
+inline bool Path::getDir (size_t item) const
+{
+    assert(item + 1 < ids_.getSize());
+
+    return (dirs_[item / 8] >> (item % 8)) & 1;
+}
+
+//------------------------------------------------------------------------------
+
+inline const unsigned char* Path::getDirs () const
+{
+    return (dirs_.getSize() == 0) ? nullptr : &dirs_[0];
+}
+
+//------------------------------------------------------------------------------
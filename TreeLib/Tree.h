@@ -15,7 +15,11 @@
 #define _CRT_SECURE_NO_WARNINGS
 
 
+#include "../LogLib/Log.h"
+#include "../MetricLib/Metric.h"
 #include "../StringLib/StringLib.h"
+#include "../PackLib/Pack.h"
+#include "../ThreadLib/ThreadPool.h"
 
 #define NO_DUMP
 #define NO_HASH
@@ -23,6 +27,10 @@
 #undef NO_HASH
 #undef NO_DUMP
 
+#include "../StackLib/SmallStack.h"
+#include "Path.h"
+#include "Writer.h"
+
 #include "TreeConfig.h"
 #include <type_traits>
 #include <assert.h>
@@ -31,21 +39,22 @@
 #include <string.h>
 #include <stdio.h>
 #include <time.h>
+#include <atomic>
 #include <new>
 
 
-#define TREE_CHECK if (Check ())                            \
-                   {                                        \
-                     Dump(DUMP_NAME);                       \
-                     TREE_ASSERTOK(errCode_, errCode_, -1); \
-                   } //
+#define TREE_CHECK(...) if (Check ())                                                                  \
+                        {                                                                              \
+                          PrintError(TREE_LOGNAME , __FILE__, __LINE__, __FUNC_NAME__, errCode_, -1); \
+                          return __VA_ARGS__;                                                          \
+                        } //
 
 
-#define TREE_ASSERTOK(cond, err, line) if (cond)                                                                  \
-                                       {                                                                          \
-                                         PrintError(TREE_LOGNAME , __FILE__, __LINE__, __FUNC_NAME__, err, line); \
-                                         exit(err);                                                               \
-                                       } //
+#define TREE_ASSERTOK(cond, err, line, ...) if (cond)                                                                  \
+                                            {                                                                          \
+                                              PrintError(TREE_LOGNAME , __FILE__, __LINE__, __FUNC_NAME__, err, line); \
+                                              return __VA_ARGS__;                                                      \
+                                            } //
 
 #define CHECK_BRACKET(lines_arr, line, bracket)          \
         (                                                \
@@ -78,6 +87,131 @@ template<typename TYPE> bool isPOISON  (Tree<TYPE> tree);
 template<typename TYPE> void TypePrint (FILE* fp, const Tree<TYPE>& tree);
 
 
+struct NodeStats
+{
+    std::atomic<size_t> visits_  {0};
+    std::atomic<size_t> yes_     {0};
+    std::atomic<size_t> no_      {0};
+    std::atomic<size_t> guesses_ {0};
+
+//------------------------------------------------------------------------------
+/*! @brief   Node statistics default constructor.
+ */
+
+    NodeStats ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Node statistics copy constructor.
+ *
+ *  @param   obj         Source statistics
+ */
+
+    NodeStats (const NodeStats& obj);
+
+    NodeStats& operator = (const NodeStats& obj);
+
+//------------------------------------------------------------------------------
+/*! @brief   Count a visit of the node.
+ */
+
+    void addVisit ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Count an answer given in the node.
+ *
+ *  @param   ans         true if answer is yes, false if no
+ */
+
+    void addAnswer (bool ans);
+
+//------------------------------------------------------------------------------
+/*! @brief   Count a final guess in the node.
+ */
+
+    void addGuess ();
+
+//------------------------------------------------------------------------------
+};
+
+
+struct PageEntry
+{
+    unsigned long long begin = 0;
+    unsigned long long end   = 0;
+    unsigned long long count = 0;
+};
+
+struct PageHeader
+{
+    char               sign[8] = {};
+    unsigned long long size    = 0;
+    unsigned long long mtime   = 0;
+    unsigned long long depth   = 0;
+    unsigned long long num     = 0;
+};
+
+template <typename TYPE>
+class Node;
+
+template <typename TYPE>
+struct Page
+{
+    PageEntry   entry;
+    size_t      id     = 0;
+    bool        loaded = false;
+    bool        dirty  = false;
+
+    Node<TYPE>* node = nullptr;
+    Page*       prev = nullptr;
+    Page*       next = nullptr;
+
+    char*       stats       = nullptr; // statistics lines of the unloaded nodes below the page root
+    size_t      stats_size  = 0;
+    size_t      stats_lines = 0;
+
+//------------------------------------------------------------------------------
+/*! @brief   Page default constructor.
+ */
+
+    Page ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Page copy constructor (deleted).
+ *
+ *  @param   obj         Source page
+ */
+
+    Page (const Page& obj);
+
+    Page& operator = (const Page& obj); // deleted
+
+//------------------------------------------------------------------------------
+/*! @brief   Page destructor, kept statistics are freed.
+ */
+
+   ~Page ();
+
+//------------------------------------------------------------------------------
+};
+
+template <typename TYPE>
+struct GraphItem
+{
+    Node<TYPE>* node   = nullptr;
+    size_t      parent = 0;
+    size_t      depth  = 0;
+    bool        yes    = false;
+};
+
+template <typename TYPE>
+struct WritePart
+{
+    Node<TYPE>*           node = nullptr;
+    Writer                text;
+    SmallStack<PageEntry> pages;
+    int                   err  = TREE_OK;
+};
+
 template <typename TYPE>
 class Node
 {
@@ -85,6 +219,14 @@ class Node
 
     TYPE data_      = POISON<TYPE>;
     bool is_string_ = false;
+    bool in_pool_   = false;
+
+    unsigned int len_ = 0; // length of the string label, it is counted once when the label is set
+
+    char* shard_   = nullptr;
+    bool  fetched_ = false;
+
+    Page<TYPE>* page_ = nullptr;
 
 public:
 
@@ -94,6 +236,13 @@ public:
 
     size_t depth_ = 0;
 
+    size_t pre_        = 0;
+    size_t end_        = 0;
+    size_t leaf_begin_ = 0;
+    size_t leaf_end_   = 0;
+
+    NodeStats stats_;
+
 //------------------------------------------------------------------------------
 /*! @brief   Node default constructor.
 */
@@ -124,6 +273,14 @@ public:
 
     const TYPE& getData ();
 
+//------------------------------------------------------------------------------
+/*! @brief   Get length of the string label without scanning it.
+ *
+ *  @return  length of the label, 0 if the data is not a string
+ */
+
+    size_t getLen () const;
+
 //------------------------------------------------------------------------------
 /*! @brief   Recursive depth recount.
  */
@@ -136,6 +293,31 @@ public:
 
     void recountPrev ();
 
+//------------------------------------------------------------------------------
+/*! @brief   Recursive count of nodes in the subtree.
+ *
+ *  @return  number of nodes
+ */
+
+    size_t Count ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Check that the node is a mount point or a page of the base whose
+ *           content is not loaded yet.
+ *
+ *  @return  1 if the content is not loaded, 0 if it is or the node is not a mount point
+ */
+
+    bool isMount () const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Check that the node starts a page of the base when it is written.
+ *
+ *  @return  1 if the node depth is a nonzero multiple of PAGE_DEPTH, else 0
+ */
+
+    bool isPageRoot () const;
+
 //------------------------------------------------------------------------------
 /*! @brief   Node copy constructor.
  *
@@ -160,33 +342,113 @@ private:
     int AddFromBase (const Text& base, size_t& line_cur);
 
 //------------------------------------------------------------------------------
-/*! @brief   Recursive tree writing to file.
+/*! @brief   Recursive tree writing to the base text.
+ *
+ *  @note    Mount points below the top node are written as mount lines and
+ *           their loaded shards are written back to the shard files. Nodes
+ *           of the parts are not written again, their texts and pages are
+ *           added instead.
+ *
+ *  @param   out         Base text
+ *  @param   top         Top node of the written subtree (nullptr for the whole tree)
+ *  @param   pages       Index of pages to fill (nullptr if not needed)
+ *  @param   parts       Subtrees written already (nullptr if there are none)
+ *  @param   parts_num   Number of the written subtrees
  *
- *  @param   base        Base file
+ *  @return  first error of the parts and the shards, the rest of the subtree
+ *           is written anyway. Errors of the base text are kept by the writer
  */
 
-    void Write (FILE* base);
+    int Write (Writer& out, Node* top, SmallStack<PageEntry>* pages, WritePart<TYPE>* parts = nullptr, size_t parts_num = 0);
+
+//------------------------------------------------------------------------------
+/*! @brief   Write the subtree as a standalone base.
+ *
+ *  @param   basename    Name of the base file
+ *  @param   compact     true to write lines without indentation
+ *
+ *  @return  error code
+ */
+
+    int WriteBase (const char* basename, bool compact);
+
+//------------------------------------------------------------------------------
+/*! @brief   Recursively load pages and shards of all mount points in the subtree.
+ *
+ *  @param   tree        Tree of the node
+ *  @param   shards      Load shards too, not only pages of the base
+ *
+ *  @return  error code
+ */
+
+    int FetchAll (Tree<TYPE>& tree, bool shards);
+
+//------------------------------------------------------------------------------
+/*! @brief   Recursively drop page descriptors of the subtree.
+ *
+ *  @param   tree        Tree of the node
+ */
+
+    void Unpage (Tree<TYPE>& tree);
+
+//------------------------------------------------------------------------------
+/*! @brief   Recursive statistics writing.
+ *
+ *  @note    Page roots have the number of lines below them in place of the
+ *           label, unloaded pages write the statistics kept in their records.
+ *
+ *  @param   out         Statistics writer
+ */
+
+    void WriteStats (Writer& out);
+
+//------------------------------------------------------------------------------
+/*! @brief   Count statistics lines written below the node.
+ *
+ *  @return  number of lines
+ */
+
+    size_t statLines () const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Recursive statistics reading from the statistics text, lines below
+ *           unloaded pages are kept in their records until they are loaded.
+ *
+ *  @param   stat        Statistics text
+ *  @param   line_cur    Current line in the statistics text
+ *
+ *  @return  1 if node data matches the line, 0 if not
+ */
+
+    bool ReadStats (const Text& stat, size_t& line_cur);
 
 //------------------------------------------------------------------------------
 /*! @brief   Recursively find path to the element.
  *
  *  @param   path        Path to the element
  *  @param   elem        Data of node
+ *  @param   dir         Direction from the parent (true - yes, false - no)
  *
  *  @return  1 if found, 0 if not
  */
 
-    bool findPath (Stack<size_t>& path, TYPE elem);
+    bool findPath (Path& path, TYPE elem, bool dir);
 
 //------------------------------------------------------------------------------
-/*! @brief   Recursive node checker.
+/*! @brief   Recursive preorder numbering of nodes and leaves.
  *
  *  @param   tree        Tree of the node
+ */
+
+    void Number (Tree<TYPE>& tree);
+
+//------------------------------------------------------------------------------
+/*! @brief   Check links and depth of the node without its subtrees.
  *
  *  @return  error code
  */
 
-    int Check (Tree<TYPE>& tree);
+    int Check () const;
 
 //------------------------------------------------------------------------------
 /*! @brief   Recursive print the contents of the tree like a graphviz dot file.
@@ -196,6 +458,37 @@ private:
 
     void Dump (FILE* dump);
 
+//------------------------------------------------------------------------------
+/*! @brief   Get children of the node ordered by number of visits.
+ *
+ *  @param   hot         More visited child (right one if equal)
+ *  @param   cold        Less visited child
+ */
+
+    void hotChildren (Node*& hot, Node*& cold);
+
+//------------------------------------------------------------------------------
+/*! @brief   Allocate own copy of the label, it is counted in the node strings memory.
+ *
+ *  @param   label       Label
+ *  @param   len         Length of the label
+ *
+ *  @return  copy of the label
+ */
+
+    static char* newLabel (const char* label, size_t len);
+
+//------------------------------------------------------------------------------
+/*! @brief   Free own copy of the label.
+ *
+ *  @note    Labels are never changed in place, so the length gives the size
+ *           they were counted with.
+ *
+ *  @param   label       Copy of the label made by newLabel
+ */
+
+    static void deleteLabel (char* label);
+
 //------------------------------------------------------------------------------
 };
 
@@ -210,6 +503,29 @@ class Tree
 
     Stack<TYPE> path2badnode_;
 
+    Node<TYPE>* pool_      = nullptr;
+    char*       text_pool_ = nullptr;
+    size_t      text_size_ = 0;
+
+    Node<TYPE>** order_      = nullptr;
+    Node<TYPE>** leaves_     = nullptr;
+    size_t       nodes_num_  = 0;
+    size_t       leaves_num_ = 0;
+    bool         numbered_   = false;
+
+    char*       pagename_     = nullptr;
+    size_t      pages_num_    = 0;
+    Page<TYPE>* lru_head_     = nullptr;
+    Page<TYPE>* lru_tail_     = nullptr;
+    size_t      pages_loaded_ = 0;
+    size_t      evictions_    = 0;
+
+    bool packed_  = false;
+    bool compact_ = COMPACT_BASE;
+
+    char** labels_     = nullptr;
+    size_t labels_cap_ = 0;
+
 public:
 
     char* name_ = nullptr;
@@ -240,6 +556,9 @@ public:
 
 //------------------------------------------------------------------------------
 /*! @brief   Tree constructor with base.
+ *
+ *  @note    If the base has an up to date page index, only the top pages are
+ *           loaded and deeper ones are loaded by Fetch.
  *
  *  @param   tree_name   Tree variable name
  *  @param   base_name   Base filename
@@ -269,6 +588,26 @@ public:
 
     void Clean ();
 
+//------------------------------------------------------------------------------
+/*! @brief   Relay out the tree into one contiguous node array ordered by access
+ *           frequency.
+ *
+ *  @note    The top hot_depth levels are stored breadth-first, deeper nodes are
+ *           stored depth-first with the most visited child first, and leaves
+ *           visited less than cold_visits times are moved with their data to
+ *           the end of the array. With share identical labels are stored once
+ *           and the nodes point to the same copy, a node given new data by
+ *           setData gets its own copy.
+ *
+ *  @param   hot_depth   Number of levels stored breadth-first
+ *  @param   cold_visits Number of visits below which a leaf is cold
+ *  @param   share       Share identical labels
+ *
+ *  @return  error code
+ */
+
+    int Relayout (size_t hot_depth = HOT_LAYOUT_DEPTH, size_t cold_visits = COLD_VISITS, bool share = SHARE_LABELS);
+
 //------------------------------------------------------------------------------
 /*! @brief   Print the contents of the tree like a graphviz dot file.
  *
@@ -278,13 +617,50 @@ public:
     void Dump (const char* dumpname = DUMP_NAME);
 
 //------------------------------------------------------------------------------
-/*! @brief   Write the tree data to the base file.
+/*! @brief   Write the tree data to the base file and its page index.
+ *
+ *  @note    All pages of the base are loaded before writing.
  *
  *  @param   basename    Base file name
  */
 
     void Write (const char* basename = DEFAULT_BASE_NAME);
 
+//------------------------------------------------------------------------------
+/*! @brief   Write the tree data to the block compressed base file.
+ *
+ *  @note    Tree loaded from a packed base is written packed by Write too.
+ *
+ *  @param   basename    Packed base file name
+ *
+ *  @return  error code
+ */
+
+    int Pack (const char* basename);
+
+//------------------------------------------------------------------------------
+/*! @brief   Write node statistics to the statistics file.
+ *
+ *  @param   statname    Statistics file name
+ *
+ *  @return  error code
+ */
+
+    int WriteStats (const char* statname);
+
+//------------------------------------------------------------------------------
+/*! @brief   Read node statistics from the statistics file.
+ *
+ *  @note    Nodes are matched in the order of the base file, reading stops
+ *           at the first node whose data differs from the statistics line.
+ *
+ *  @param   statname    Statistics file name
+ *
+ *  @return  error code
+ */
+
+    int ReadStats (const char* statname);
+
 //------------------------------------------------------------------------------
 /*! @brief   Find path in the tree to the element.
  *
@@ -294,15 +670,226 @@ public:
  *  @return  1 if found, 0 if not
  */
 
-    bool findPath (Stack<size_t>& path, TYPE elem);
+    bool findPath (Path& path, TYPE elem);
+
+//------------------------------------------------------------------------------
+/*! @brief   Get path from the root to the node.
+ *
+ *  @param   node        Node
+ *  @param   path        Path to the node
+ *
+ *  @return  error code
+ */
+
+    int getPath (Node<TYPE>* node, Path& path);
+
+//------------------------------------------------------------------------------
+/*! @brief   Replace the node by a new feature node with a new leaf as one child
+ *           and the node as the other.
+ *
+ *  @param   node        Node to be replaced
+ *  @param   feature     Data of the feature node
+ *  @param   leaf        Data of the leaf
+ *  @param   yes         Leaf is the yes-child if true, the no-child if false
+ *
+ *  @return  new feature node
+ */
+
+    Node<TYPE>* Branch (Node<TYPE>* node, TYPE feature, TYPE leaf, bool yes = true);
 
 //------------------------------------------------------------------------------
-/*! @brief   Check tree for problems.
+/*! @brief   Write the subtree to its own base file.
+ *
+ *  @param   sub         Root of the subtree
+ *  @param   basename    Name of the base file
  *
  *  @return  error code
  */
 
-    int Check ();
+    int Export (Node<TYPE>* sub, const char* basename);
+
+//------------------------------------------------------------------------------
+/*! @brief   Write the subtree as a graph, every node once with its number as id.
+ *
+ *  @note    Mount points are not loaded and nodes at the depth limit are not
+ *           expanded, both are drawn dashed. JSON graph is a list of nodes
+ *           with ids of their parents.
+ *
+ *  @param   sub         Root of the subtree
+ *  @param   filename    Name of the graph file
+ *  @param   format      GRAPH_DOT for graphviz or GRAPH_JSON
+ *  @param   max_depth   Number of levels below the root, 0 for the whole subtree
+ *
+ *  @return  error code
+ */
+
+    int Graph (Node<TYPE>* sub, const char* filename, int format = GRAPH_DOT, size_t max_depth = 0);
+
+//------------------------------------------------------------------------------
+/*! @brief   Make the subtree a mount point of the shard file.
+ *
+ *  @note    The subtree stays loaded, Write puts a mount line in its place
+ *           and writes the subtree to the shard file.
+ *
+ *  @param   sub         Root of the subtree
+ *  @param   shardname   Name of the shard file
+ *
+ *  @return  error code
+ */
+
+    int Mount (Node<TYPE>* sub, const char* shardname);
+
+//------------------------------------------------------------------------------
+/*! @brief   Load the page or the shard of the mount point in place of the node.
+ *
+ *  @note    If too many pages are loaded, the least visited ones which were
+ *           not changed and are not above the node are unloaded, the least
+ *           recently used first of equally visited.
+ *
+ *  @param   node        Mount point
+ *
+ *  @return  error code
+ */
+
+    int Fetch (Node<TYPE>* node);
+
+//------------------------------------------------------------------------------
+/*! @brief   Load all pages and shards of all mount points.
+ *
+ *  @return  error code
+ */
+
+    int FetchAll ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Find the mount point which may hold the label.
+ *
+ *  @note    The base file is scanned line by line, nothing is loaded. A page
+ *           below an unloaded one is found after its parent is fetched.
+ *           Shards are not scanned, so if no page has the label, the first
+ *           shard not loaded yet is returned.
+ *
+ *  @param   label       Label
+ *  @param   match       Comparator of a trimmed base line with the label
+ *
+ *  @return  unloaded page with the label or shard if found, else nullptr
+ */
+
+    Node<TYPE>* findPage (const char* label, bool (*match)(const char* line, const char* label));
+
+//------------------------------------------------------------------------------
+/*! @brief   Unload the least visited pages over the limit, the least
+ *           recently used first of equally visited.
+ *
+ *  @param   keep        Node whose pages above must stay loaded
+ */
+
+    void Evict (Node<TYPE>* keep = nullptr);
+
+//------------------------------------------------------------------------------
+/*! @brief   Mark the page started by the node as the most recently used.
+ *
+ *  @param   node        Node
+ */
+
+    void Touch (Node<TYPE>* node);
+
+//------------------------------------------------------------------------------
+/*! @brief   Get number of pages unloaded to free memory.
+ *
+ *  @return  number of unloaded pages
+ */
+
+    size_t getEvictions () const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Number nodes in preorder (yes-child first).
+ *
+ *  @note    Every subtree takes the node ids [pre_, end_) and the leaf ids
+ *           [leaf_begin_, leaf_end_). Numbers are rebuilt lazily by the
+ *           functions below after the tree has been changed.
+ *
+ *  @return  error code
+ */
+
+    int Number ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Check that the node lies in the subtree.
+ *
+ *  @param   node        Node
+ *  @param   sub         Root of the subtree (e.g. yes- or no-child of a feature)
+ *
+ *  @return  1 if node is in the subtree, 0 if not
+ */
+
+    bool isUnder (Node<TYPE>* node, Node<TYPE>* sub);
+
+//------------------------------------------------------------------------------
+/*! @brief   Get leaf ids of the subtree.
+ *
+ *  @param   sub         Root of the subtree
+ *  @param   begin       First leaf id
+ *  @param   end         Leaf id after the last one
+ */
+
+    void leafRange (Node<TYPE>* sub, size_t& begin, size_t& end);
+
+//------------------------------------------------------------------------------
+/*! @brief   Get node by its preorder id.
+ *
+ *  @param   id          Node id
+ *
+ *  @return  node
+ */
+
+    Node<TYPE>* getNode (size_t id);
+
+//------------------------------------------------------------------------------
+/*! @brief   Get leaf by its preorder leaf id.
+ *
+ *  @param   id          Leaf id
+ *
+ *  @return  leaf
+ */
+
+    Node<TYPE>* getLeaf (size_t id);
+
+//------------------------------------------------------------------------------
+/*! @brief   Check tree for problems in one pass without recursion.
+ *
+ *  @note    Links and depths of every node are checked and then the node is
+ *           given to the check of the caller. Top levels are checked until
+ *           there are CHECK_TASKS subtrees, the subtrees are checked by the
+ *           thread pool and the bad node of the first failed subtree is
+ *           taken, so the result does not depend on the threads. Path to the
+ *           bad node is kept for PrintError and getBadPath.
+ *
+ *  @param   check       Check of the node data, nullptr if not needed, it is
+ *                       called from several threads
+ *  @param   check_err   Error code of the check if it rejected a node
+ *
+ *  @return  error code, TREE_WRONG_NODE_DATA if the check rejected a node
+ */
+
+    int Check (int (*check)(Node<TYPE>* node) = nullptr, int* check_err = nullptr);
+
+//------------------------------------------------------------------------------
+/*! @brief   Get path to the bad node found by the last check.
+ *
+ *  @return  labels from the bad node up to the root
+ */
+
+    const Stack<TYPE>& getBadPath () const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Set writing of the base without indentation, the base is read
+ *           the same way but it is smaller and faster to write.
+ *
+ *  @param   compact     true to write lines without indentation
+ */
+
+    void setCompact (bool compact);
 
 //------------------------------------------------------------------------------
 /*! @brief   Get error code of the tree.
@@ -343,6 +930,206 @@ public:
 
     void PrintBase (Text& base, size_t line, const char* logname);
 
+/*------------------------------------------------------------------------------
+                   Private functions                                           *
+*///----------------------------------------------------------------------------
+
+private:
+
+//------------------------------------------------------------------------------
+/*! @brief   Check the subtree in one preorder pass, it goes down by verified
+ *           links and returns up by prev_, so it needs no stack and visits
+ *           the pool of a relayouted tree almost sequentially.
+ *
+ *  @param   sub         Root of the subtree, its link to the parent is checked
+ *  @param   check       Check of the node data, nullptr if not needed
+ *  @param   check_err   Error code of the check if it rejected a node
+ *  @param   bad         First bad node if it is found
+ *
+ *  @return  error code
+ */
+
+    static int checkSubtree (Node<TYPE>* sub, int (*check)(Node<TYPE>* node), int& check_err, Node<TYPE>*& bad);
+
+//------------------------------------------------------------------------------
+/*! @brief   Write the subtree, subtrees of its wide levels are written by the
+ *           thread pool to their own texts and then added in order.
+ *
+ *  @param   sub         Root of the written subtree
+ *  @param   top         Top node of the written subtree (nullptr for the whole tree)
+ *  @param   out         Base text
+ *  @param   pages       Index of pages to fill (nullptr if not needed)
+ *
+ *  @return  error code
+ */
+
+    static int writeNodes (Node<TYPE>* sub, Node<TYPE>* top, Writer& out, SmallStack<PageEntry>* pages);
+
+//------------------------------------------------------------------------------
+/*! @brief   Check links and depth of the node and then its data.
+ *
+ *  @param   node        Node
+ *  @param   check       Check of the node data, nullptr if not needed
+ *  @param   check_err   Error code of the check if it rejected the node
+ *
+ *  @return  error code
+ */
+
+    static int checkNode (Node<TYPE>* node, int (*check)(Node<TYPE>* node), int& check_err);
+
+//------------------------------------------------------------------------------
+/*! @brief   Delete all tree nodes, both allocated by new and stored in the pool.
+ */
+
+    void Free ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Create the tree from the base text.
+ *
+ *  @param   base        Base text
+ *
+ *  @return  error code
+ */
+
+    int Parse (Text& base);
+
+//------------------------------------------------------------------------------
+/*! @brief   Replace the node content by the root of a loaded tree.
+ *
+ *  @param   node        Node to be replaced
+ *  @param   root        Root of the loaded tree, left without children
+ */
+
+    void Splice (Node<TYPE>* node, Node<TYPE>* root);
+
+//------------------------------------------------------------------------------
+/*! @brief   Load the shard of the mount point.
+ *
+ *  @param   node        Mount point
+ *
+ *  @return  error code
+ */
+
+    int FetchShard (Node<TYPE>* node);
+
+//------------------------------------------------------------------------------
+/*! @brief   Load the page of the base.
+ *
+ *  @param   node        Page node
+ *  @param   evict       Unload cold pages if too many are loaded
+ *
+ *  @return  error code
+ */
+
+    int FetchPage (Node<TYPE>* node, bool evict);
+
+//------------------------------------------------------------------------------
+/*! @brief   Unload the page, its loaded subpages are dropped and statistics
+ *           of all unloaded nodes are kept in the page record.
+ *
+ *  @param   page        Page
+ */
+
+    void Unload (Page<TYPE>* page);
+
+//------------------------------------------------------------------------------
+/*! @brief   Put the statistics kept in the record of the loaded page back to its nodes.
+ *
+ *  @param   page        Page
+ */
+
+    void restoreStats (Page<TYPE>* page);
+
+//------------------------------------------------------------------------------
+/*! @brief   Link the page to the head of the list of loaded pages.
+ *
+ *  @param   page        Page
+ */
+
+    void Link (Page<TYPE>* page);
+
+//------------------------------------------------------------------------------
+/*! @brief   Unlink the page from the list of loaded pages.
+ *
+ *  @param   page        Page
+ */
+
+    void Unlink (Page<TYPE>* page);
+
+//------------------------------------------------------------------------------
+/*! @brief   Mark pages containing the node as changed, so they are never unloaded.
+ *
+ *  @param   node        Changed node
+ */
+
+    void markDirty (Node<TYPE>* node);
+
+//------------------------------------------------------------------------------
+/*! @brief   Find slot of the label in the shared labels table.
+ *
+ *  @param   label       Label
+ *
+ *  @return  slot with the same label or empty slot
+ */
+
+    size_t labelSlot (const char* label) const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Set node data, the shared copy is used if there is one.
+ *
+ *  @param   node        Node
+ *  @param   data        Node data
+ */
+
+    void shareData (Node<TYPE>* node, TYPE data);
+
+//------------------------------------------------------------------------------
+/*! @brief   Replace own labels of the subtree nodes with shared copies.
+ *
+ *  @param   node        Root of the subtree
+ */
+
+    void shareLabels (Node<TYPE>* node);
+
+//------------------------------------------------------------------------------
+/*! @brief   Drop all page descriptors, the tree is kept in memory entirely.
+ */
+
+    void Unpage ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Open the page index of the base if it is up to date.
+ *
+ *  @param   basename    Base file name
+ *
+ *  @return  error code
+ */
+
+    int openIndex (const char* basename);
+
+//------------------------------------------------------------------------------
+/*! @brief   Write the page index of the base.
+ *
+ *  @param   basename    Base file name
+ *  @param   pages       Page entries in preorder
+ *
+ *  @return  error code
+ */
+
+    int writeIndex (const char* basename, SmallStack<PageEntry>& pages);
+
+//------------------------------------------------------------------------------
+/*! @brief   Read text of the page with its subpages replaced by page lines.
+ *
+ *  @param   page        Page (nullptr for the top of the base)
+ *  @param   text        Page text, allocated by calloc
+ *  @param   size        Size of the page text
+ *
+ *  @return  error code
+ */
+
+    int readPage (Page<TYPE>* page, char*& text, size_t& size);
+
 //------------------------------------------------------------------------------
 };
 
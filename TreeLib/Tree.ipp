@@ -8,8 +8,74 @@
     * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
     *///------------------------------------------------------------------------
 
+inline NodeStats::NodeStats () { }
+
+//------------------------------------------------------------------------------
+
+inline NodeStats::NodeStats (const NodeStats& obj)
+{
+    *this = obj;
+}
+
+//------------------------------------------------------------------------------
+
+inline NodeStats& NodeStats::operator = (const NodeStats& obj)
+{
+    visits_ .store(obj.visits_ .load(std::memory_order_relaxed), std::memory_order_relaxed);
+    yes_    .store(obj.yes_    .load(std::memory_order_relaxed), std::memory_order_relaxed);
+    no_     .store(obj.no_     .load(std::memory_order_relaxed), std::memory_order_relaxed);
+    guesses_.store(obj.guesses_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    return *this;
+}
+
+//------------------------------------------------------------------------------
+
+inline void NodeStats::addVisit ()
+{
+    visits_.fetch_add(1, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+inline void NodeStats::addAnswer (bool ans)
+{
+    if (ans) yes_.fetch_add(1, std::memory_order_relaxed);
+    else     no_ .fetch_add(1, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+inline void NodeStats::addGuess ()
+{
+    guesses_.fetch_add(1, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+Page<TYPE>::Page () { }
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+Page<TYPE>::~Page ()
+{
+    if (stats != nullptr) MET_FREE(MEM_TEXTS, stats_size + 2);
+
+    free(stats);
+    stats       = nullptr;
+    stats_size  = 0;
+    stats_lines = 0;
+}
+
+//------------------------------------------------------------------------------
+
 template <typename TYPE>
-Node<TYPE>::Node () { }
+Node<TYPE>::Node ()
+{
+    MET_ALLOC(MEM_NODES, sizeof(Node<TYPE>));
+}
 
 //------------------------------------------------------------------------------
 
@@ -37,7 +103,7 @@ Tree<TYPE>::Tree (char* tree_name, Node<TYPE>* root) :
     path2badnode_ ((char*)"path to problem node"),
     errCode_      (TREE_OK)
 {
-    TREE_CHECK;
+    TREE_CHECK();
 }
 
 //------------------------------------------------------------------------------
@@ -49,16 +115,72 @@ Tree<TYPE>::Tree (char* tree_name, char* base_filename) :
     path2badnode_ ((char*)"path to problem node"),
     errCode_      (TREE_OK)
 {
-    TREE_ASSERTOK((tree_name == nullptr), TREE_WRONG_INPUT_TREE_NAME, -1);
+    MET_TIMER(MET_LOAD);
+
+    if (tree_name == nullptr)
+    {
+        PrintError(TREE_LOGNAME, __FILE__, __LINE__, __FUNC_NAME__, TREE_WRONG_INPUT_TREE_NAME, -1);
+        errCode_ = TREE_WRONG_INPUT_TREE_NAME;
+        return;
+    }
 
     root_ = new Node<TYPE>;
 
-    Text base(base_filename);
+    char*  text = nullptr;
+    size_t size = 0;
+    int    err  = TREE_OK;
+
+    if (IsPacked(base_filename))
+    {
+        PackFile pack;
+
+        err = pack.Open(base_filename);
+        if (err == PCK_OK) err = pack.ReadAll(text, size);
+
+        if (err == PCK_OK)
+        {
+            packed_ = true;
+
+            Text base(text, size);
+            err = Parse(base);
+        }
+        else
+        {
+            PrintError(TREE_LOGNAME, __FILE__, __LINE__, __FUNC_NAME__, TREE_WRONG_PACK, -1);
+            err = TREE_WRONG_PACK;
+        }
+    }
+    else if ((openIndex(base_filename) == TREE_OK) && (readPage(nullptr, text, size) == TREE_OK))
+    {
+        Text base(text, size);
+        err = Parse(base);
+    }
+    else
+    {
+        delete [] pagename_;
+        pagename_ = nullptr;
+
+        Text base(base_filename);
+        err = Parse(base);
+    }
+
+    // broken base leaves an empty tree with the error code instead of stopping the program
+    if (err != TREE_OK)
+    {
+        Free();
+        errCode_ = err;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::Parse (Text& base)
+{
+    TREE_ASSERTOK(((base.lines_ == nullptr) || (base.num_ < 2)), TREE_WRONG_SYNTAX_INPUT_BASE, -1, TREE_WRONG_SYNTAX_INPUT_BASE);
+    TREE_ASSERTOK(CHECK_BRACKET(base.lines_, 0,             OPEN_BRACKET),  TREE_WRONG_SYNTAX_INPUT_BASE, 0,             TREE_WRONG_SYNTAX_INPUT_BASE);
+    TREE_ASSERTOK(CHECK_BRACKET(base.lines_, base.num_ - 2, CLOSE_BRACKET), TREE_WRONG_SYNTAX_INPUT_BASE, base.num_ - 2, TREE_WRONG_SYNTAX_INPUT_BASE);
 
-    TREE_ASSERTOK((base.num_ < 2), TREE_WRONG_SYNTAX_INPUT_BASE, -1);
-    TREE_ASSERTOK(CHECK_BRACKET(base.lines_, 0,             OPEN_BRACKET),  TREE_WRONG_SYNTAX_INPUT_BASE, 0);
-    TREE_ASSERTOK(CHECK_BRACKET(base.lines_, base.num_ - 2, CLOSE_BRACKET), TREE_WRONG_SYNTAX_INPUT_BASE, base.num_ - 2);
-    
     size_t line_cur = 1;
     if (base.lines_[line_cur].str[0] != CLOSE_BRACKET)
     {
@@ -66,11 +188,13 @@ Tree<TYPE>::Tree (char* tree_name, char* base_filename) :
         {
             PrintError(TREE_LOGNAME, __FILE__, __LINE__, __FUNC_NAME__, TREE_WRONG_SYNTAX_INPUT_BASE, line_cur);
             PrintBase(base, line_cur, TREE_LOGNAME);
-            exit(TREE_WRONG_SYNTAX_INPUT_BASE);
-        };
+            return TREE_WRONG_SYNTAX_INPUT_BASE;
+        }
     }
 
-    TREE_CHECK;
+    TREE_CHECK(errCode_);
+
+    return TREE_OK;
 }
 
 //------------------------------------------------------------------------------
@@ -107,11 +231,14 @@ Tree<TYPE>::~Tree ()
 
     else if (errCode_ != TREE_DESTRUCTED)
     {
-        if (root_ != nullptr)
-        {
-            delete root_;
-            root_ = nullptr;
-        }
+        Free();
+
+        delete [] pagename_;
+        pagename_ = nullptr;
+
+        delete [] labels_;
+        labels_     = nullptr;
+        labels_cap_ = 0;
 
         errCode_ = TREE_DESTRUCTED;
     }
@@ -126,13 +253,43 @@ Tree<TYPE>::~Tree ()
 template <typename TYPE>
 void Tree<TYPE>::Clean ()
 {
-    TREE_CHECK;
+    TREE_CHECK();
 
-    if (root_ != nullptr)
-    {
+    Free();
+    Unpage();
+
+    delete [] labels_;
+    labels_     = nullptr;
+    labels_cap_ = 0;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Tree<TYPE>::Free ()
+{
+    if ((root_ != nullptr) && (not root_->in_pool_))
         delete root_;
-        root_ = nullptr;
-    }
+
+    root_ = nullptr;
+
+    delete [] pool_;
+    pool_ = nullptr;
+
+    if (text_pool_ != nullptr) MET_FREE(MEM_STRINGS, text_size_);
+
+    delete [] text_pool_;
+    text_pool_ = nullptr;
+    text_size_ = 0;
+
+    delete [] order_;
+    delete [] leaves_;
+    order_      = nullptr;
+    leaves_     = nullptr;
+    nodes_num_  = 0;
+    leaves_num_ = 0;
+    numbered_   = false;
+
 }
 
 //------------------------------------------------------------------------------
@@ -140,6 +297,8 @@ void Tree<TYPE>::Clean ()
 template <typename TYPE>
 Node<TYPE>::Node (const Node& obj)
 {
+    MET_ALLOC(MEM_NODES, sizeof(Node<TYPE>));
+
     *this = obj;
 }
 
@@ -151,20 +310,40 @@ Node<TYPE>& Node<TYPE>::operator = (const Node& obj)
     if constexpr (std::is_same<TYPE, char*>::value)
     {
         if (is_string_)
-            delete [] data_;
+            deleteLabel(data_);
 
-        if (obj.is_string_)
-            data_ = new char[strlen(obj.data_) + 2] {};
+        data_      = POISON<TYPE>;
+        len_       = 0;
+        is_string_ = false;
 
-        strcpy(data_, obj.data_);
+        if (obj.data_ != nullptr)
+        {
+            data_      = newLabel(obj.data_, obj.len_);
+            len_       = obj.len_;
+            is_string_ = true;
+        }
+    }
+    else
+    {
+        data_      = obj.data_;
+        is_string_ = obj.is_string_;
     }
-    else data_ = obj.data_;
 
-    is_string_ = obj.is_string_;
+    stats_ = obj.stats_;
+
+    delete [] shard_;
+    shard_   = nullptr;
+    fetched_ = obj.fetched_;
+
+    if (obj.shard_ != nullptr)
+    {
+        shard_ = new char [strlen(obj.shard_) + 1];
+        strcpy(shard_, obj.shard_);
+    }
 
     if (obj.right_ != nullptr)
     {
-        if (right_ != nullptr) delete right_;
+        if ((right_ != nullptr) && (not right_->in_pool_)) delete right_;
         right_ = new Node<TYPE>;
 
         *right_ = *obj.right_;
@@ -172,13 +351,13 @@ Node<TYPE>& Node<TYPE>::operator = (const Node& obj)
     }
     else if (right_ != nullptr)
     {
-        delete right_;
+        if (not right_->in_pool_) delete right_;
         right_ = nullptr;
     }
     
     if (obj.left_ != nullptr)
     {
-        if (left_ != nullptr) delete left_;
+        if ((left_ != nullptr) && (not left_->in_pool_)) delete left_;
         left_ = new Node<TYPE>;
 
         *left_ = *obj.left_;
@@ -186,7 +365,7 @@ Node<TYPE>& Node<TYPE>::operator = (const Node& obj)
     }
     else if (left_ != nullptr)
     {
-        delete left_;
+        if (not left_->in_pool_) delete left_;
         left_ = nullptr;
     }
 
@@ -201,23 +380,33 @@ Node<TYPE>& Node<TYPE>::operator = (const Node& obj)
 template <typename TYPE>
 Node<TYPE>::~Node ()
 {
+    MET_FREE(MEM_NODES, sizeof(Node<TYPE>));
+
     if (right_ != nullptr)
     {
-        delete right_;
+        if (not right_->in_pool_) delete right_;
         right_ = nullptr;
     }
 
     if (left_ != nullptr)
     {
-        delete left_;
+        if (not left_->in_pool_) delete left_;
         left_  = nullptr;
     }
 
     prev_ = nullptr;
 
-    if constexpr (std::is_same<TYPE, char*>::value) if (is_string_) delete [] data_;
+    delete [] shard_;
+    shard_   = nullptr;
+    fetched_ = false;
+
+    delete page_;
+    page_ = nullptr;
+
+    if constexpr (std::is_same<TYPE, char*>::value) if (is_string_) deleteLabel(data_);
 
     is_string_ = false;
+    len_       = 0;
 
     data_ = POISON<TYPE>;
 }
@@ -237,15 +426,32 @@ int Node<TYPE>::AddFromBase (const Text& base, size_t& line_cur)
 
     if constexpr (std::is_same<TYPE, char*>::value)
     {
-        data_ = new char [base.lines_[line_cur].len + 2];
-        strcpy(data_, base.lines_[line_cur].str);
+        // the parser has measured the line, so the label is not scanned again
+        len_  = base.lines_[line_cur].len;
+        data_ = newLabel(base.lines_[line_cur].str, len_);
         ++line_cur;
 
         is_string_ = true;
+
+        if (data_[0] == MOUNT_SIGN)
+        {
+            shard_ = new char [strlen(data_)];
+            strcpy(shard_, data_ + 1);
+        }
     }
     else
         sscanf(base.lines_[line_cur++].str, PRINT_FORMAT<TYPE>, &data_);
 
+    if (base.lines_[line_cur - 1].str[0] == PAGE_SIGN)
+    {
+        page_ = new Page<TYPE>;
+        page_->node = this;
+
+        if (sscanf(base.lines_[line_cur - 1].str + 1, "%lu %llu %llu %llu", &page_->id,
+                   &page_->entry.begin, &page_->entry.end, &page_->entry.count) != 4)
+            return line_cur - 1;
+    }
+
     if (base.lines_[line_cur].str[0] == OPEN_BRACKET)
     {
         if (CHECK_BRACKET(base.lines_, line_cur, OPEN_BRACKET)) return line_cur;
@@ -341,6 +547,9 @@ void Node<TYPE>::Dump (FILE* dump)
     fprintf(dump, " this: " PRINT_PTR "\\n depth: %lu\\n data: [", this, depth_);
     TypePrint(dump, data_);
     fprintf(dump, "]\\n left: " PRINT_PTR " | right: " PRINT_PTR "\\n", left_, right_);
+    fprintf(dump, " visits: %lu | yes: %lu | no: %lu | guesses: %lu\\n",
+            stats_.visits_.load(std::memory_order_relaxed), stats_.yes_    .load(std::memory_order_relaxed),
+            stats_.no_    .load(std::memory_order_relaxed), stats_.guesses_.load(std::memory_order_relaxed));
     fprintf(dump, "\" [shape = box, style = filled, color = black, fillcolor = lightskyblue]\n");
 
     if (left_ != nullptr)
@@ -385,242 +594,2050 @@ void Node<TYPE>::Dump (FILE* dump)
 template <typename TYPE>
 void Tree<TYPE>::Write (const char* basename)
 {
-    TREE_CHECK;
+    MET_TIMER(MET_WRITE);
+
+    TREE_CHECK();
+
+    if (pagename_ != nullptr)
+    {
+        int err = (root_ != nullptr) ? root_->FetchAll(*this, false) : TREE_OK;
+        if (err)
+        {
+            PrintError(TREE_LOGNAME, __FILE__, __LINE__, __FUNC_NAME__, err, -1);
+            return;
+        }
+
+        Unpage();
+    }
+
+    if (packed_)
+    {
+        int err = Pack(basename);
+        if (err) PrintError(TREE_LOGNAME, __FILE__, __LINE__, __FUNC_NAME__, err, -1);
+
+        return;
+    }
 
     FILE* base = fopen(basename, "w");
-    assert(base != nullptr);
+    TREE_ASSERTOK((base == nullptr), TREE_WRONG_WRITE, -1);
+
+    SmallStack<PageEntry> pages;
+    Writer out(base, compact_);
 
-    fprintf(base, "%c\n", OPEN_BRACKET);
-    if (root_ != nullptr) root_->Write(base);
-    fprintf(base, "%c", CLOSE_BRACKET);
+    out.Write(OPEN_BRACKET);
+    out.Write('\n');
+    int err = (root_ != nullptr) ? writeNodes(root_, nullptr, out, &pages) : TREE_OK;
+    out.Write(CLOSE_BRACKET);
 
+    // the written part is kept in the file, but the error is reported and no index is written
+    int flush_err = out.Flush();
+    if (err == TREE_OK) err = flush_err;
     fclose(base);
+
+    TREE_ASSERTOK(err, err, -1);
+
+    writeIndex(basename, pages);
 }
 
 //------------------------------------------------------------------------------
 
 template <typename TYPE>
-void Node<TYPE>::Write (FILE* base)
+int Tree<TYPE>::Pack (const char* basename)
 {
-    assert(base != nullptr);
+    assert(basename != nullptr);
 
-    for (int i = 0; i <= depth_; ++i) fprintf(base, "    ");
-    TypePrint(base, data_);
-    fprintf(base, "\n");
+    TREE_CHECK(errCode_);
 
-    if (right_ != nullptr)
+    if (root_ != nullptr)
     {
-        for (int i = 0; i <= depth_; ++i) fprintf(base, "    ");
-        fprintf(base, "[\n");
-
-        right_->Write(base);
-        
-        for (int i = 0; i <= depth_; ++i) fprintf(base, "    ");
-        fprintf(base, "]\n");
+        int err = root_->FetchAll(*this, false);
+        if (err) return err;
     }
 
-    if (left_ != nullptr)
-    {
-        for (int i = 0; i <= depth_; ++i) fprintf(base, "    ");
-        fprintf(base, "[\n");
+    // text is kept in memory and packed at once
+    Writer out(nullptr, compact_);
 
-        if (left_ != nullptr) left_->Write(base);
+    out.Write(OPEN_BRACKET);
+    out.Write('\n');
+    int err = (root_ != nullptr) ? writeNodes(root_, nullptr, out, nullptr) : TREE_OK;
+    out.Write(CLOSE_BRACKET);
 
-        for (int i = 0; i <= depth_; ++i) fprintf(base, "    ");
-        fprintf(base, "]\n");
-    }
+    if (err)              return err;
+    if (out.getErrCode()) return out.getErrCode();
+
+    err = PackText(basename, out.getText(), out.getPos());
+
+    return (err == PCK_OK) ? TREE_OK : TREE_WRONG_PACK;
 }
 
 //------------------------------------------------------------------------------
 
 template <typename TYPE>
-void Node<TYPE>::setData (TYPE data)
+int Node<TYPE>::Write (Writer& out, Node* top, SmallStack<PageEntry>* pages, WritePart<TYPE>* parts, size_t parts_num)
 {
-    if constexpr (std::is_same<TYPE, char*>::value) if (is_string_) delete [] data_;
-    is_string_ = false;
+    for (size_t i = 0; i < parts_num; ++i)
+        if (parts[i].node == this)
+        {
+            int err = (parts[i].err != TREE_OK) ? parts[i].err : parts[i].text.getErrCode();
 
-    data_ = data;
-}
+            size_t shift = out.getPos();
 
-//------------------------------------------------------------------------------
+            if (parts[i].text.getText() != nullptr)
+                out.Write(parts[i].text.getText(), parts[i].text.getPos());
 
-template <typename TYPE>
-const TYPE& Node<TYPE>::getData ()
-{
-    return data_;
-}
+            if (pages != nullptr)
+                for (size_t j = 0; j < parts[i].pages.getSize(); ++j)
+                {
+                    PageEntry page = parts[i].pages[j];
+                    page.begin += shift;
+                    page.end   += shift;
 
-//------------------------------------------------------------------------------
+                    pages->Push(page);
+                }
 
-template <typename TYPE>
-void Node<TYPE>::recountDepth ()
-{
-    assert(this != nullptr);
+            return err;
+        }
 
-    if (prev_ == nullptr)
-        depth_ = 0;
-    else
-        depth_ = prev_->depth_ + 1;
+    size_t indent = depth_ - ((top == nullptr) ? 0 : top->depth_) + 1;
 
-    if (right_ != nullptr) right_->recountDepth();
-    if (left_  != nullptr) left_->recountDepth();
-}
+    // the rest is written after an error, so the base stays whole if only a shard fails
+    int err = TREE_OK;
 
-//------------------------------------------------------------------------------
+    size_t entry = 0;
+    bool   paged = (pages != nullptr) && isPageRoot();
 
-template <typename TYPE>
-void Node<TYPE>::recountPrev ()
-{
-    assert(this != nullptr);
+    if (paged)
+    {
+        PageEntry page;
+        page.begin = out.getPos();
 
-    if (right_ != nullptr)
+        entry = pages->getSize();
+        pages->Push(page);
+    }
+
+    if ((shard_ != nullptr) && (this != top))
     {
-        right_->prev_ = this;
-        right_->recountPrev();
+        out.Indent(indent);
+        out.Write(MOUNT_SIGN);
+        out.Write(shard_, strlen(shard_));
+        out.Write('\n');
+
+        if (fetched_) err = WriteBase(shard_, out.isCompact());
     }
-    if (left_  != nullptr)
+    else
     {
-        left_->prev_ = this;
-        left_->recountPrev();
+        out.Indent(indent);
+        out.Print(data_);
+        out.Write('\n');
+
+        if (right_ != nullptr)
+        {
+            out.Indent(indent);
+            out.Write("[\n", 2);
+
+            int right_err = right_->Write(out, top, pages, parts, parts_num);
+            if (err == TREE_OK) err = right_err;
+
+            out.Indent(indent);
+            out.Write("]\n", 2);
+        }
+
+        if (left_ != nullptr)
+        {
+            out.Indent(indent);
+            out.Write("[\n", 2);
+
+            int left_err = left_->Write(out, top, pages, parts, parts_num);
+            if (err == TREE_OK) err = left_err;
+
+            out.Indent(indent);
+            out.Write("]\n", 2);
+        }
+    }
+
+    if (paged)
+    {
+        (*pages)[entry].end   = out.getPos();
+        (*pages)[entry].count = pages->getSize() - entry - 1;
     }
+
+    return err;
 }
 
 //------------------------------------------------------------------------------
 
 template <typename TYPE>
-bool Tree<TYPE>::findPath (Stack<size_t>& path, TYPE elem)
+int Node<TYPE>::WriteBase (const char* basename, bool compact)
 {
-    TREE_CHECK;
+    assert(basename != nullptr);
 
-    TREE_ASSERTOK((isPOISON(elem)), TREE_INPUT_DATA_POISON, -1);
+    FILE* base = fopen(basename, "w");
+    if (base == nullptr) return TREE_WRONG_WRITE;
 
-    bool found = root_->findPath(path, elem);
+    Writer out(base, compact);
 
-    return found;
+    out.Write(OPEN_BRACKET);
+    out.Write('\n');
+    int err = Tree<TYPE>::writeNodes(this, this, out, nullptr);
+    out.Write(CLOSE_BRACKET);
+
+    int flush_err = out.Flush();
+    if (err == TREE_OK) err = flush_err;
+    fclose(base);
+
+    return err;
 }
 
 //------------------------------------------------------------------------------
 
 template <typename TYPE>
-bool Node<TYPE>::findPath (Stack<size_t>& path, TYPE elem)
+int Tree<TYPE>::WriteStats (const char* statname)
 {
-    path.Push((size_t)this);
-    
-    bool found = false;
+    assert(statname != nullptr);
 
-    if (right_ != nullptr)
+    TREE_CHECK(errCode_);
+
+    FILE* stat = fopen(statname, "w");
+    TREE_ASSERTOK((stat == nullptr), TREE_WRONG_WRITE, -1, TREE_WRONG_WRITE);
+
+    Writer out(stat);
+    if (root_ != nullptr) root_->WriteStats(out);
+
+    int err = out.Flush();
+    fclose(stat);
+
+    TREE_ASSERTOK(err, err, -1, err);
+
+    return TREE_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Node<TYPE>::WriteStats (Writer& out)
+{
+    out.Number(stats_.visits_ .load(std::memory_order_relaxed));
+    out.Write(' ');
+    out.Number(stats_.yes_    .load(std::memory_order_relaxed));
+    out.Write(' ');
+    out.Number(stats_.no_     .load(std::memory_order_relaxed));
+    out.Write(' ');
+    out.Number(stats_.guesses_.load(std::memory_order_relaxed));
+    out.Write(' ');
+
+    // the page may be unloaded when the statistics are read, so its lines are counted
+    if (isPageRoot())
     {
-        found = right_->findPath(path, elem);
-        if (found) return found;
+        out.Write(PAGE_SIGN);
+        out.Number(statLines());
     }
-    if (left_ != nullptr)
+    else if (shard_ != nullptr)
     {
-        found = left_->findPath(path, elem);
-        if (found) return found;
+        out.Write(MOUNT_SIGN);
+        out.Write(shard_, strlen(shard_));
     }
+    else
+        out.Print(data_);
 
-    if ((left_ == nullptr) && (right_ == nullptr))
+    out.Write('\n');
+
+    if ((page_ != nullptr) && (not page_->loaded))
     {
-        if constexpr (std::is_same<TYPE, char*>::value)
-            found = (strcmp(elem, data_) == 0);
-        else
-            found = (elem == data_);
+        if (page_->stats != nullptr) out.Write(page_->stats, page_->stats_size);
+        return;
     }
 
-    if (not found) path.Pop();
+    if (shard_ != nullptr) return;
 
-    return found;
+    if (right_ != nullptr) right_->WriteStats(out);
+    if (left_  != nullptr) left_ ->WriteStats(out);
 }
 
 //------------------------------------------------------------------------------
 
-template<typename TYPE>
-bool isPOISON (Tree<TYPE> tree)
+template <typename TYPE>
+size_t Node<TYPE>::statLines () const
 {
-    return ( (tree.name_        == nullptr) &&
-             (tree.root_        == nullptr) &&
-             (tree.getId()      == 0)       &&
-             (tree.getErrCode() == 0) );
-}
+    if ((page_ != nullptr) && (not page_->loaded)) return page_->stats_lines;
 
-//------------------------------------------------------------------------------
+    if (shard_ != nullptr) return 0;
 
-template<typename TYPE>
-void TypePrint (FILE* fp, const Tree<TYPE>& tree)
-{
-    fprintf(fp, "%s", tree.name_);
+    size_t lines = 0;
+    if (right_ != nullptr) lines += right_->statLines() + 1;
+    if (left_  != nullptr) lines += left_ ->statLines() + 1;
+
+    return lines;
 }
 
 //------------------------------------------------------------------------------
 
 template <typename TYPE>
-int Tree<TYPE>::Check ()
+int Tree<TYPE>::ReadStats (const char* statname)
 {
-    int err = TREE_OK;
+    assert(statname != nullptr);
 
-    if (root_ != nullptr)
-        err = root_->Check(*this);
+    TREE_CHECK(errCode_);
 
-    errCode_ = err;
+    FILE* fp = fopen(statname, "r");
+    if (fp == nullptr) return TREE_OK;
 
-    return err;
+    size_t size = CountSize(fp);
+    fclose(fp);
+
+    if ((size == 0) || (root_ == nullptr)) return TREE_OK;
+
+    Text stat(statname);
+
+    size_t line_cur = 0;
+    root_->ReadStats(stat, line_cur);
+
+    return TREE_OK;
 }
 
 //------------------------------------------------------------------------------
 
 template <typename TYPE>
-int Node<TYPE>::Check (Tree<TYPE>& tree)
+bool Node<TYPE>::ReadStats (const Text& stat, size_t& line_cur)
 {
-    if (((prev_ == nullptr) && (depth_ != 0)) ||
-        ((prev_ != nullptr) && (depth_ != prev_->depth_ + 1)))
+    if (line_cur >= stat.num_) return false;
+
+    size_t visits  = 0;
+    size_t yes     = 0;
+    size_t no      = 0;
+    size_t guesses = 0;
+    int    shift   = 0;
+
+    if (sscanf(stat.lines_[line_cur].str, "%lu %lu %lu %lu %n", &visits, &yes, &no, &guesses, &shift) != 4)
+        return false;
+
+    char*  label = stat.lines_[line_cur].str + shift;
+    size_t lines = 0;
+
+    // page roots are not compared, unloaded page has only the placeholder
+    if (isPageRoot())
     {
-        tree.path2badnode_.Push(data_);
-        return TREE_WRONG_DEPTH;
+        if ((label[0] != PAGE_SIGN) || (sscanf(label + 1, "%lu", &lines) != 1)) return false;
     }
-
-    if (prev_ != nullptr)
-        if ((prev_->right_ != this) &&
-            (prev_->left_  != this))
+    else if constexpr (std::is_same<TYPE, char*>::value)
+    {
+        if (strcmp(label, data_) != 0) return false;
+    }
+    else
+    {
+        TYPE data = POISON<TYPE>;
+        sscanf(label, PRINT_FORMAT<TYPE>, &data);
+        if (data != data_) return false;
+    }
+
+    stats_.visits_ .store(visits,  std::memory_order_relaxed);
+    stats_.yes_    .store(yes,     std::memory_order_relaxed);
+    stats_.no_     .store(no,      std::memory_order_relaxed);
+    stats_.guesses_.store(guesses, std::memory_order_relaxed);
+    ++line_cur;
+
+    if ((page_ != nullptr) && (not page_->loaded))
+    {
+        if (lines > stat.num_ - line_cur) return false;
+
+        if (page_->stats != nullptr) MET_FREE(MEM_TEXTS, page_->stats_size + 2);
+        free(page_->stats);
+
+        size_t size = 0;
+        for (size_t i = line_cur; i < line_cur + lines; ++i)
+            size += stat.lines_[i].len + 1;
+
+        page_->stats       = (size == 0) ? nullptr : (char*)calloc(size + 2, 1);
+        page_->stats_size  = (page_->stats == nullptr) ? 0 : size;
+        page_->stats_lines = (page_->stats == nullptr) ? 0 : lines;
+
+        if (page_->stats != nullptr)
+        {
+            MET_ALLOC(MEM_TEXTS, size + 2);
+
+            char* cur = page_->stats;
+            for (size_t i = line_cur; i < line_cur + lines; ++i)
+            {
+                memcpy(cur, stat.lines_[i].str, stat.lines_[i].len);
+                cur += stat.lines_[i].len;
+                *cur++ = '\n';
+            }
+        }
+
+        line_cur += lines;
+        return true;
+    }
+
+    if (shard_ != nullptr) return true;
+
+    size_t first = line_cur;
+
+    if ((right_ != nullptr) && (not right_->ReadStats(stat, line_cur))) return false;
+    if ((left_  != nullptr) && (not left_ ->ReadStats(stat, line_cur))) return false;
+
+    return (not isPageRoot()) || (line_cur - first == lines);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Node<TYPE>::setData (TYPE data)
+{
+    if constexpr (std::is_same<TYPE, char*>::value)
+    {
+        if (is_string_) deleteLabel(data_);
+
+        len_       = strlen(data);
+        data_      = newLabel(data, len_);
+        is_string_ = true;
+    }
+    else data_ = data;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+const TYPE& Node<TYPE>::getData ()
+{
+    return data_;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+size_t Node<TYPE>::getLen () const
+{
+    return len_;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Node<TYPE>::recountDepth ()
+{
+    assert(this != nullptr);
+
+    if (prev_ == nullptr)
+        depth_ = 0;
+    else
+        depth_ = prev_->depth_ + 1;
+
+    if (right_ != nullptr) right_->recountDepth();
+    if (left_  != nullptr) left_->recountDepth();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Node<TYPE>::recountPrev ()
+{
+    assert(this != nullptr);
+
+    if (right_ != nullptr)
+    {
+        right_->prev_ = this;
+        right_->recountPrev();
+    }
+    if (left_  != nullptr)
+    {
+        left_->prev_ = this;
+        left_->recountPrev();
+    }
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+size_t Node<TYPE>::Count ()
+{
+    size_t num = 1;
+
+    if (right_ != nullptr) num += right_->Count();
+    if (left_  != nullptr) num += left_ ->Count();
+
+    return num;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+bool Node<TYPE>::isMount () const
+{
+    return ((shard_ != nullptr) && (not fetched_)) || ((page_ != nullptr) && (not page_->loaded));
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+bool Node<TYPE>::isPageRoot () const
+{
+    return (depth_ != 0) && (depth_ % PAGE_DEPTH == 0);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Node<TYPE>::hotChildren (Node*& hot, Node*& cold)
+{
+    hot  = right_;
+    cold = left_;
+
+    if ((hot == nullptr) ||
+        ((cold != nullptr) && (cold->stats_.visits_.load(std::memory_order_relaxed) >
+                               hot ->stats_.visits_.load(std::memory_order_relaxed))))
+    {
+        hot  = left_;
+        cold = right_;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+char* Node<TYPE>::newLabel (const char* label, size_t len)
+{
+    assert(label != nullptr);
+
+    size_t size = len + 2;
+
+    char* copy = new char [size] {};
+    memcpy(copy, label, len);
+
+    MET_ALLOC(MEM_STRINGS, size);
+
+    return copy;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Node<TYPE>::deleteLabel (char* label)
+{
+    if (label == nullptr) return;
+
+    MET_FREE(MEM_STRINGS, strlen(label) + 2);
+
+    delete [] label;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::Relayout (size_t hot_depth, size_t cold_visits, bool share)
+{
+    MET_TIMER(MET_RELAYOUT);
+
+    TREE_CHECK(errCode_);
+
+    if (root_ == nullptr) return TREE_OK;
+
+    size_t num = root_->Count();
+
+    Node<TYPE>** order = new Node<TYPE>* [num];
+    Node<TYPE>** cold  = new Node<TYPE>* [num];
+    Node<TYPE>** stack = new Node<TYPE>* [num];
+
+    size_t order_num = 0;
+    size_t cold_num  = 0;
+
+    // top levels breadth-first, the order array itself is the queue
+    order[order_num++] = root_;
+    for (size_t head = 0; head < order_num; ++head)
+    {
+        Node<TYPE>* node = order[head];
+        if (node->depth_ + 1 >= hot_depth) continue;
+
+        Node<TYPE>* hot_child  = nullptr;
+        Node<TYPE>* cold_child = nullptr;
+        node->hotChildren(hot_child, cold_child);
+
+        if (hot_child  != nullptr) order[order_num++] = hot_child;
+        if (cold_child != nullptr) order[order_num++] = cold_child;
+    }
+
+    // subtrees below the top levels depth-first, hot child first
+    size_t top_num = order_num;
+    for (size_t i = 0; i < top_num; ++i)
+    {
+        Node<TYPE>* top = order[i];
+        if (top->depth_ + 1 < hot_depth) continue;
+
+        Node<TYPE>* hot_child  = nullptr;
+        Node<TYPE>* cold_child = nullptr;
+        top->hotChildren(hot_child, cold_child);
+
+        size_t stack_num = 0;
+        if (cold_child != nullptr) stack[stack_num++] = cold_child;
+        if (hot_child  != nullptr) stack[stack_num++] = hot_child;
+
+        while (stack_num > 0)
+        {
+            Node<TYPE>* node = stack[--stack_num];
+
+            if ((node->right_ == nullptr) && (node->left_ == nullptr))
+            {
+                if (node->stats_.visits_ < cold_visits)
+                    cold[cold_num++] = node;
+                else
+                    order[order_num++] = node;
+
+                continue;
+            }
+
+            order[order_num++] = node;
+
+            node->hotChildren(hot_child, cold_child);
+
+            if (cold_child != nullptr) stack[stack_num++] = cold_child;
+            if (hot_child  != nullptr) stack[stack_num++] = hot_child;
+        }
+    }
+
+    for (size_t i = 0; i < cold_num; ++i)
+        order[order_num++] = cold[i];
+
+    assert(order_num == num);
+
+    delete [] labels_;
+    labels_     = nullptr;
+    labels_cap_ = 0;
+
+    char** copies = nullptr;
+
+    // the table is filled with old labels first, they are replaced by the copies
+    if (std::is_same<TYPE, char*>::value && share)
+    {
+        labels_cap_ = 1;
+        while (labels_cap_ < num * 2) labels_cap_ *= 2;
+
+        labels_ = new char* [labels_cap_] {};
+        copies  = new char* [labels_cap_] {};
+    }
+
+    size_t text_size = 0;
+    if constexpr (std::is_same<TYPE, char*>::value)
+        for (size_t i = 0; i < num; ++i)
+        {
+            if (labels_ != nullptr)
+            {
+                size_t slot = labelSlot(order[i]->data_);
+                if (labels_[slot] != nullptr) continue;
+
+                labels_[slot] = order[i]->data_;
+            }
+
+            text_size += order[i]->len_ + 1;
+        }
+
+    Node<TYPE>* pool      = new Node<TYPE> [num];
+    char*       text_pool = (text_size != 0) ? new char [text_size] : nullptr;
+    char*       text_cur  = text_pool;
+
+    // Every parent is placed before its children, so after a node is moved its
+    // old prev_ is reused as a forwarding pointer to the new place.
+    for (size_t i = 0; i < num; ++i)
+    {
+        Node<TYPE>* old_node = order[i];
+        Node<TYPE>* new_node = pool + i;
+
+        if constexpr (std::is_same<TYPE, char*>::value)
+        {
+            size_t slot = (labels_ != nullptr) ? labelSlot(old_node->data_) : 0;
+
+            if ((copies != nullptr) && (copies[slot] != nullptr))
+                new_node->data_ = copies[slot];
+            else
+            {
+                memcpy(text_cur, old_node->data_, old_node->len_ + 1);
+                new_node->data_ = text_cur;
+                text_cur += old_node->len_ + 1;
+
+                if (copies != nullptr) copies[slot] = new_node->data_;
+            }
+        }
+        else new_node->data_ = old_node->data_;
+
+        new_node->len_     = old_node->len_;
+        new_node->in_pool_ = true;
+        new_node->depth_   = old_node->depth_;
+        new_node->stats_   = old_node->stats_;
+        new_node->shard_   = old_node->shard_;
+        new_node->fetched_ = old_node->fetched_;
+        new_node->page_    = old_node->page_;
+        old_node->shard_   = nullptr;
+        old_node->page_    = nullptr;
+
+        if (new_node->page_ != nullptr) new_node->page_->node = new_node;
+
+        Node<TYPE>* old_prev = old_node->prev_;
+        if (old_prev != nullptr)
+        {
+            new_node->prev_ = old_prev->prev_;
+
+            if (old_prev->right_ == old_node)
+                new_node->prev_->right_ = new_node;
+            else
+                new_node->prev_->left_  = new_node;
+        }
+
+        old_node->prev_ = new_node;
+    }
+
+    if (copies != nullptr)
+    {
+        for (size_t i = 0; i < labels_cap_; ++i)
+            labels_[i] = copies[i];
+
+        delete [] copies;
+    }
+
+    delete [] order;
+    delete [] cold;
+    delete [] stack;
+
+    Free();
+
+    root_      = pool;
+    pool_      = pool;
+    text_pool_ = text_pool;
+    text_size_ = text_size;
+
+    if (text_pool_ != nullptr) MET_ALLOC(MEM_STRINGS, text_size_);
+
+    TREE_CHECK(errCode_);
+
+    return TREE_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+bool Tree<TYPE>::findPath (Path& path, TYPE elem)
+{
+    MET_TIMER(MET_FIND_PATH);
+
+    TREE_CHECK(false);
+
+    TREE_ASSERTOK((isPOISON(elem)), TREE_INPUT_DATA_POISON, -1, false);
+
+    if (not numbered_) Number();
+
+    bool found = root_->findPath(path, elem, false);
+
+    return found;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::getPath (Node<TYPE>* node, Path& path)
+{
+    TREE_ASSERTOK((node == nullptr), TREE_NULL_INPUT_NODE_PTR, -1, TREE_NULL_INPUT_NODE_PTR);
+
+    if (not numbered_) Number();
+
+    SmallStack<Node<TYPE>*> nodes;
+    for (; node != nullptr; node = node->prev_)
+        if (nodes.Push(node)) return TREE_NO_MEMORY;
+
+    path.Clean();
+
+    for (size_t i = nodes.getSize(); i > 0; --i)
+    {
+        Node<TYPE>* cur = nodes[i - 1];
+        bool        yes = (cur->prev_ != nullptr) && (cur->prev_->right_ == cur);
+
+        if (path.Push(cur->pre_, yes)) return TREE_NO_MEMORY;
+    }
+
+    return TREE_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+bool Node<TYPE>::findPath (Path& path, TYPE elem, bool dir)
+{
+    path.Push(pre_, dir);
+    
+    bool found = false;
+
+    if (right_ != nullptr)
+    {
+        found = right_->findPath(path, elem, true);
+        if (found) return found;
+    }
+    if (left_ != nullptr)
+    {
+        found = left_->findPath(path, elem, false);
+        if (found) return found;
+    }
+
+    if ((left_ == nullptr) && (right_ == nullptr))
+    {
+        if constexpr (std::is_same<TYPE, char*>::value)
+            found = (strcmp(elem, data_) == 0);
+        else
+            found = (elem == data_);
+    }
+
+    if (not found) path.Pop();
+
+    return found;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::Number ()
+{
+    TREE_CHECK(errCode_);
+
+    delete [] order_;
+    delete [] leaves_;
+    order_      = nullptr;
+    leaves_     = nullptr;
+    nodes_num_  = 0;
+    leaves_num_ = 0;
+
+    if (root_ == nullptr) return TREE_OK;
+
+    size_t num = root_->Count();
+
+    order_  = new Node<TYPE>* [num];
+    leaves_ = new Node<TYPE>* [num];
+
+    root_->Number(*this);
+    numbered_ = true;
+
+    return TREE_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Node<TYPE>::Number (Tree<TYPE>& tree)
+{
+    pre_        = tree.nodes_num_;
+    leaf_begin_ = tree.leaves_num_;
+
+    tree.order_[tree.nodes_num_++] = this;
+
+    if ((right_ == nullptr) && (left_ == nullptr))
+        tree.leaves_[tree.leaves_num_++] = this;
+
+    if (right_ != nullptr) right_->Number(tree);
+    if (left_  != nullptr) left_ ->Number(tree);
+
+    end_      = tree.nodes_num_;
+    leaf_end_ = tree.leaves_num_;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+Node<TYPE>* Tree<TYPE>::Branch (Node<TYPE>* node, TYPE feature, TYPE leaf, bool yes)
+{
+    TREE_ASSERTOK((node == nullptr), TREE_NULL_INPUT_NODE_PTR, -1, nullptr);
+    TREE_ASSERTOK((isPOISON(feature) || isPOISON(leaf)), TREE_INPUT_DATA_POISON, -1, nullptr);
+
+    Node<TYPE>* prev = node->prev_;
+
+    Node<TYPE>* feature_node = new Node<TYPE>;
+    feature_node->prev_ = prev;
+    shareData(feature_node, feature);
+
+    if (prev == nullptr)
+        root_ = feature_node;
+    else if (prev->right_ == node)
+        prev->right_ = feature_node;
+    else
+        prev->left_  = feature_node;
+
+    Node<TYPE>* leaf_node = new Node<TYPE>;
+    leaf_node->prev_ = feature_node;
+    leaf_node->setData(leaf);
+
+    feature_node->right_ = (yes) ? leaf_node : node;
+    feature_node->left_  = (yes) ? node : leaf_node;
+    node->prev_          = feature_node;
+
+    feature_node->recountDepth();
+    markDirty(feature_node);
+
+    numbered_ = false;
+
+    return feature_node;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::Export (Node<TYPE>* sub, const char* basename)
+{
+    TREE_ASSERTOK((sub == nullptr), TREE_NULL_INPUT_NODE_PTR, -1, TREE_NULL_INPUT_NODE_PTR);
+    assert(basename != nullptr);
+
+    TREE_CHECK(errCode_);
+
+    int err = sub->FetchAll(*this, false);
+    if (err) return err;
+
+    return sub->WriteBase(basename, compact_);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::Graph (Node<TYPE>* sub, const char* filename, int format, size_t max_depth)
+{
+    TREE_ASSERTOK((sub == nullptr), TREE_NULL_INPUT_NODE_PTR, -1, TREE_NULL_INPUT_NODE_PTR);
+    assert(filename != nullptr);
+
+    FILE* graph = fopen(filename, "w");
+    if (graph == nullptr) return TREE_WRONG_WRITE;
+
+    Writer out(graph);
+
+    if (format == GRAPH_DOT)
+    {
+        out.Write("digraph G\n{\n    labelloc = \"t\";\n    label = ");
+        out.Quote(name_);
+        out.Write(";\n    node [shape = box, style = filled, color = black];\n\n");
+    }
+    else
+    {
+        out.Write("{\n    \"name\": ");
+        out.Quote(name_);
+        out.Write(",\n    \"nodes\":\n    [");
+    }
+
+    // nodes are numbered in preorder, edges are written with the child
+    SmallStack<GraphItem<TYPE>> items;
+
+    GraphItem<TYPE> item;
+    item.node = sub;
+    items.Push(item);
+
+    int err = TREE_OK;
+    for (size_t id = 0; (items.getSize() != 0) && (err == TREE_OK); ++id)
+    {
+        item = items.Pop();
+        Node<TYPE>* node = item.node;
+
+        bool mount = node->isMount();
+        bool leaf  = (node->left_ == nullptr) && (node->right_ == nullptr);
+        bool cut   = (not mount) && (not leaf) && (max_depth != 0) && (item.depth >= max_depth);
+
+        if (format == GRAPH_DOT)
+        {
+            out.Write("    n");
+            out.Number(id);
+            out.Write(" [label = ");
+            out.Quote(node->data_);
+
+            if      (mount || cut) out.Write(", fillcolor = lightgray, style = \"filled,dashed\"];\n");
+            else if (leaf)         out.Write(", fillcolor = orange];\n");
+            else                   out.Write(", fillcolor = lightskyblue];\n");
+
+            if (item.depth != 0)
+            {
+                out.Write("    n");
+                out.Number(item.parent);
+                out.Write(" -> n");
+                out.Number(id);
+                if (item.yes) out.Write(" [label = \"Yes\"];\n");
+                else          out.Write(" [label = \"No\"];\n");
+            }
+        }
+        else
+        {
+            if (id != 0) out.Write(',');
+            out.Write("\n        {\"id\": ");
+            out.Number(id);
+
+            if (item.depth == 0) out.Write(", \"parent\": null, \"answer\": null");
+            else
+            {
+                out.Write(", \"parent\": ");
+                out.Number(item.parent);
+                if (item.yes) out.Write(", \"answer\": \"yes\"");
+                else          out.Write(", \"answer\": \"no\"");
+            }
+
+            out.Write(", \"label\": ");
+            out.Quote(node->data_);
+
+            if      (mount) out.Write(", \"kind\": \"mount\"}");
+            else if (cut)   out.Write(", \"kind\": \"cut\"}");
+            else if (leaf)  out.Write(", \"kind\": \"leaf\"}");
+            else            out.Write(", \"kind\": \"node\"}");
+        }
+
+        if (mount || leaf || cut) continue;
+
+        // no-child is pushed first, so the yes-child is numbered first
+        GraphItem<TYPE> child;
+        child.parent = id;
+        child.depth  = item.depth + 1;
+
+        Node<TYPE>* children[2] = { node->left_, node->right_ };
+        for (int yes = 0; (yes < 2) && (err == TREE_OK); ++yes)
+        {
+            if (children[yes] == nullptr) continue;
+
+            child.node = children[yes];
+            child.yes  = (yes == 1);
+            if (items.Push(child)) err = TREE_NO_MEMORY;
+        }
+    }
+
+    if (format == GRAPH_DOT) out.Write("}\n");
+    else                     out.Write("\n    ]\n}\n");
+
+    if (err == TREE_OK) err = out.Flush();
+    fclose(graph);
+
+    return err;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::Mount (Node<TYPE>* sub, const char* shardname)
+{
+    TREE_ASSERTOK((sub == nullptr), TREE_NULL_INPUT_NODE_PTR, -1, TREE_NULL_INPUT_NODE_PTR);
+    assert(shardname != nullptr);
+
+    delete [] sub->shard_;
+
+    sub->shard_ = new char [strlen(shardname) + 1];
+    strcpy(sub->shard_, shardname);
+
+    sub->fetched_ = true;
+    markDirty(sub);
+
+    return TREE_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::Fetch (Node<TYPE>* node)
+{
+    TREE_ASSERTOK((node == nullptr), TREE_NULL_INPUT_NODE_PTR, -1, TREE_NULL_INPUT_NODE_PTR);
+
+    while (node->isMount())
+    {
+        int err = ((node->page_ != nullptr) && (not node->page_->loaded)) ? FetchPage(node, true) : FetchShard(node);
+        if (err) return err;
+    }
+
+    return TREE_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::FetchAll ()
+{
+    TREE_CHECK(errCode_);
+
+    if (root_ == nullptr) return TREE_OK;
+
+    return root_->FetchAll(*this, true);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Node<TYPE>::FetchAll (Tree<TYPE>& tree, bool shards)
+{
+    while (true)
+    {
+        int err = TREE_OK;
+
+        if ((page_ != nullptr) && (not page_->loaded))
+            err = tree.FetchPage(this, false);
+        else if (shards && (shard_ != nullptr) && (not fetched_))
+            err = tree.FetchShard(this);
+        else
+            break;
+
+        if (err) return err;
+    }
+
+    if (right_ != nullptr)
+    {
+        int err = right_->FetchAll(tree, shards);
+        if (err) return err;
+    }
+
+    if (left_ != nullptr) return left_->FetchAll(tree, shards);
+
+    return TREE_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+Node<TYPE>* Tree<TYPE>::findPage (const char* label, bool (*match)(const char* line, const char* label))
+{
+    assert(label != nullptr);
+    assert(match != nullptr);
+
+    if (root_ == nullptr) return nullptr;
+
+    // unloaded pages are never nested, so a base line belongs to one of them at most
+    SmallStack<Node<TYPE>*> unloaded;
+    SmallStack<Node<TYPE>*> nodes;
+    Node<TYPE>*             shard = nullptr;
+
+    if (nodes.Push(root_)) return nullptr;
+
+    for (size_t i = 0; i < nodes.getSize(); ++i)
+    {
+        Node<TYPE>* node = nodes[i];
+
+        if ((node->page_ != nullptr) && (not node->page_->loaded))
+        {
+            if (unloaded.Push(node)) return nullptr;
+            continue;
+        }
+
+        if ((node->shard_ != nullptr) && (not node->fetched_))
+        {
+            if (shard == nullptr) shard = node;
+            continue;
+        }
+
+        if ((node->right_ != nullptr) && nodes.Push(node->right_)) return nullptr;
+        if ((node->left_  != nullptr) && nodes.Push(node->left_))  return nullptr;
+    }
+
+    if ((pagename_ == nullptr) || (unloaded.getSize() == 0)) return shard;
+
+    FILE* base = fopen(pagename_, "rb");
+    if (base == nullptr) return shard;
+
+    Node<TYPE>* found = nullptr;
+
+    char line[MAX_LABEL_LINE] = "";
+
+    while (found == nullptr)
+    {
+        long pos = ftell(base);
+
+        int c = 0;
+        while (((c = fgetc(base)) == ' ') || (c == '\t'));
+        if ((c == EOF) || (ungetc(c, base) == EOF) || (fgets(line, MAX_LABEL_LINE, base) == nullptr)) break;
+
+        // lines longer than the buffer are not labels
+        size_t len = strcspn(line, "\r\n");
+        if (line[len] == '\0')
+        {
+            while (((c = fgetc(base)) != EOF) && (c != '\n'));
+            continue;
+        }
+        line[len] = '\0';
+
+        if (not match(line, label)) continue;
+
+        for (size_t i = 0; (i < unloaded.getSize()) && (found == nullptr); ++i)
+        {
+            PageEntry& entry = unloaded[i]->page_->entry;
+            if ((entry.begin <= (unsigned long long)pos) && ((unsigned long long)pos < entry.end))
+                found = unloaded[i];
+        }
+    }
+
+    fclose(base);
+
+    return (found != nullptr) ? found : shard;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+size_t Tree<TYPE>::getEvictions () const
+{
+    return evictions_;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Tree<TYPE>::Splice (Node<TYPE>* node, Node<TYPE>* root)
+{
+    assert(node != nullptr);
+    assert(root != nullptr);
+
+    node->setData(root->data_);
+
+    node->right_ = root->right_;
+    node->left_  = root->left_;
+    root->right_ = nullptr;
+    root->left_  = nullptr;
+
+    if (node->right_ != nullptr) node->right_->prev_ = node;
+    if (node->left_  != nullptr) node->left_ ->prev_ = node;
+
+    // root of the loaded tree is a mount point itself
+    if (root->shard_ != nullptr)
+    {
+        delete [] node->shard_;
+        node->shard_   = root->shard_;
+        node->fetched_ = false;
+        root->shard_   = nullptr;
+    }
+
+    node->recountDepth();
+
+    numbered_ = false;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::FetchShard (Node<TYPE>* node)
+{
+    assert(node != nullptr);
+
+    FILE* fp = fopen(node->shard_, "r");
+    if (fp == nullptr) return TREE_SHARD_NOT_FOUND;
+    fclose(fp);
+
+    Tree<TYPE> shard(name_, node->shard_);
+    if (shard.errCode_ != TREE_OK) return shard.errCode_;
+
+    if (shard.pagename_ != nullptr)
+    {
+        int err = shard.root_->FetchAll(shard, false);
+        if (err) return err;
+
+        shard.Unpage();
+    }
+
+    node->fetched_ = true;
+    Splice(node, shard.root_);
+
+    return TREE_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::FetchPage (Node<TYPE>* node, bool evict)
+{
+    assert(node        != nullptr);
+    assert(node->page_ != nullptr);
+
+    MET_TIMER(MET_FETCH_PAGE);
+
+    char*  text = nullptr;
+    size_t size = 0;
+
+    int err = readPage(node->page_, text, size);
+    if (err) return err;
+
+    MET_COUNT(MET_PAGE_LOADS, 1);
+
+    Text page(text, size);
+
+    Node<TYPE>* root = new Node<TYPE>;
+
+    size_t line_cur = 0;
+    if (root->AddFromBase(page, line_cur) != 0)
+    {
+        delete root;
+        return TREE_WRONG_PAGE;
+    }
+
+    Splice(node, root);
+    delete root;
+
+    shareLabels(node);
+
+    Page<TYPE>* loaded = node->page_;
+    loaded->loaded = true;
+
+    restoreStats(loaded);
+    Link(loaded);
+
+    if (evict) Evict(node);
+
+    return TREE_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Tree<TYPE>::Evict (Node<TYPE>* keep)
+{
+    while (pages_loaded_ > PAGE_LIMIT)
+    {
+        Page<TYPE>* victim = nullptr;
+
+        // the least visited page, the least recently used one of equally visited
+        for (Page<TYPE>* page = lru_tail_; page != nullptr; page = page->prev)
+        {
+            if (page->dirty) continue;
+
+            bool above = false;
+            for (Node<TYPE>* cur = keep; (cur != nullptr) && (not above); cur = cur->prev_)
+                above = (cur == page->node);
+
+            if (above) continue;
+
+            if ((victim == nullptr) ||
+                (page->node->stats_.visits_.load(std::memory_order_relaxed) < victim->node->stats_.visits_.load(std::memory_order_relaxed)))
+                victim = page;
+        }
+
+        if (victim == nullptr) return;
+
+        Unload(victim);
+        ++evictions_;
+
+        MET_COUNT(MET_PAGE_EVICTIONS, 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Tree<TYPE>::Touch (Node<TYPE>* node)
+{
+    assert(node != nullptr);
+
+    Page<TYPE>* page = node->page_;
+    if ((page == nullptr) || (not page->loaded) || (page == lru_head_)) return;
+
+    Unlink(page);
+    Link(page);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Tree<TYPE>::Unload (Page<TYPE>* page)
+{
+    assert(page != nullptr);
+
+    Node<TYPE>* node = page->node;
+
+    // subpages are dropped with their records, so their statistics go to this page
+    Writer stats;
+    if (node->right_ != nullptr) node->right_->WriteStats(stats);
+    if (node->left_  != nullptr) node->left_ ->WriteStats(stats);
+
+    size_t lines = node->statLines();
+    size_t size  = stats.getPos();
+
+    if (page->stats != nullptr) MET_FREE(MEM_TEXTS, page->stats_size + 2);
+    free(page->stats);
+
+    page->stats       = ((size == 0) || stats.getErrCode()) ? nullptr : (char*)calloc(size + 2, 1);
+    page->stats_size  = (page->stats == nullptr) ? 0 : size;
+    page->stats_lines = (page->stats == nullptr) ? 0 : lines;
+
+    if (page->stats != nullptr)
+    {
+        memcpy(page->stats, stats.getText(), size);
+        MET_ALLOC(MEM_TEXTS, size + 2);
+    }
+
+    if (node->right_ != nullptr)
+    {
+        node->right_->Unpage(*this);
+        if (not node->right_->in_pool_) delete node->right_;
+        node->right_ = nullptr;
+    }
+
+    if (node->left_ != nullptr)
+    {
+        node->left_->Unpage(*this);
+        if (not node->left_->in_pool_) delete node->left_;
+        node->left_ = nullptr;
+    }
+
+    delete [] node->shard_;
+    node->shard_   = nullptr;
+    node->fetched_ = false;
+
+    Unlink(page);
+    page->loaded = false;
+
+    numbered_ = false;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Tree<TYPE>::restoreStats (Page<TYPE>* page)
+{
+    assert(page != nullptr);
+
+    if (page->stats == nullptr) return;
+
+    // the text takes the buffer, so it is not kept by the page any more
+    MET_FREE(MEM_TEXTS, page->stats_size + 2);
+
+    Text stats(page->stats, page->stats_size);
+    page->stats       = nullptr;
+    page->stats_size  = 0;
+    page->stats_lines = 0;
+
+    Node<TYPE>* node = page->node;
+    size_t line_cur  = 0;
+
+    if ((node->right_ != nullptr) && (not node->right_->ReadStats(stats, line_cur))) return;
+    if  (node->left_  != nullptr) node->left_->ReadStats(stats, line_cur);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Tree<TYPE>::Link (Page<TYPE>* page)
+{
+    assert(page != nullptr);
+
+    page->prev = nullptr;
+    page->next = lru_head_;
+
+    if (lru_head_ != nullptr) lru_head_->prev = page;
+    else                      lru_tail_ = page;
+
+    lru_head_ = page;
+
+    ++pages_loaded_;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Tree<TYPE>::Unlink (Page<TYPE>* page)
+{
+    assert(page != nullptr);
+
+    if (page->prev != nullptr) page->prev->next = page->next;
+    else                       lru_head_ = page->next;
+
+    if (page->next != nullptr) page->next->prev = page->prev;
+    else                       lru_tail_ = page->prev;
+
+    page->prev = nullptr;
+    page->next = nullptr;
+
+    --pages_loaded_;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Tree<TYPE>::markDirty (Node<TYPE>* node)
+{
+    for (; node != nullptr; node = node->prev_)
+        if (node->page_ != nullptr) node->page_->dirty = true;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+size_t Tree<TYPE>::labelSlot (const char* label) const
+{
+    assert(label   != nullptr);
+    assert(labels_ != nullptr);
+
+    size_t hash = 14695981039346656037ull;
+    for (const char* cur = label; *cur != '\0'; ++cur)
+        hash = (hash ^ (unsigned char)*cur) * 1099511628211ull;
+
+    size_t slot = hash & (labels_cap_ - 1);
+    while ((labels_[slot] != nullptr) && (strcmp(labels_[slot], label) != 0))
+        slot = (slot + 1) & (labels_cap_ - 1);
+
+    return slot;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Tree<TYPE>::shareData (Node<TYPE>* node, TYPE data)
+{
+    assert(node != nullptr);
+
+    if constexpr (std::is_same<TYPE, char*>::value)
+    {
+        char* shared = (labels_ != nullptr) ? labels_[labelSlot(data)] : nullptr;
+
+        if (shared != nullptr)
+        {
+            if (node->is_string_) Node<TYPE>::deleteLabel(node->data_);
+
+            node->data_      = shared;
+            node->len_       = strlen(shared);
+            node->is_string_ = false;
+            return;
+        }
+    }
+
+    node->setData(data);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Tree<TYPE>::shareLabels (Node<TYPE>* node)
+{
+    if constexpr (std::is_same<TYPE, char*>::value)
+    {
+        if ((node == nullptr) || (labels_ == nullptr)) return;
+
+        if (node->is_string_)
+        {
+            char* shared = labels_[labelSlot(node->data_)];
+            if (shared != nullptr)
+            {
+                Node<TYPE>::deleteLabel(node->data_);
+                node->data_      = shared;
+                node->is_string_ = false;
+            }
+        }
+
+        shareLabels(node->right_);
+        shareLabels(node->left_);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Tree<TYPE>::Unpage ()
+{
+    if (root_ != nullptr) root_->Unpage(*this);
+
+    delete [] pagename_;
+    pagename_     = nullptr;
+    pages_num_    = 0;
+    lru_head_     = nullptr;
+    lru_tail_     = nullptr;
+    pages_loaded_ = 0;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Node<TYPE>::Unpage (Tree<TYPE>& tree)
+{
+    if (page_ != nullptr)
+    {
+        if (page_->loaded) tree.Unlink(page_);
+
+        delete page_;
+        page_ = nullptr;
+    }
+
+    if (right_ != nullptr) right_->Unpage(tree);
+    if (left_  != nullptr) left_ ->Unpage(tree);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::openIndex (const char* basename)
+{
+    assert(basename != nullptr);
+
+    char* idxname = new char [strlen(basename) + strlen(INDEX_SUFFIX) + 1] {};
+    strcpy(idxname, basename);
+    strcat(idxname, INDEX_SUFFIX);
+
+    FILE* idx = fopen(idxname, "rb");
+    delete [] idxname;
+
+    if (idx == nullptr) return TREE_NOT_OK;
+
+    PageHeader header;
+    size_t read = fread(&header, sizeof(header), 1, idx);
+    fclose(idx);
+
+    struct stat prop;
+    if (stat(basename, &prop) != 0) return TREE_NOT_OK;
+
+    if ((read != 1) ||
+        (memcmp(header.sign, INDEX_SIGN, strlen(INDEX_SIGN) + 1) != 0) ||
+        (header.size  != (unsigned long long)prop.st_size)  ||
+        (header.mtime != (unsigned long long)prop.st_mtime) ||
+        (header.depth != PAGE_DEPTH) || (header.num == 0))
+        return TREE_NOT_OK;
+
+    pagename_ = new char [strlen(basename) + 1];
+    strcpy(pagename_, basename);
+
+    pages_num_ = header.num;
+
+    return TREE_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::writeIndex (const char* basename, SmallStack<PageEntry>& pages)
+{
+    assert(basename != nullptr);
+
+    struct stat prop;
+    if (stat(basename, &prop) != 0) return TREE_NOT_OK;
+
+    char* idxname = new char [strlen(basename) + strlen(INDEX_SUFFIX) + 1] {};
+    strcpy(idxname, basename);
+    strcat(idxname, INDEX_SUFFIX);
+
+    FILE* idx = fopen(idxname, "wb");
+    delete [] idxname;
+
+    if (idx == nullptr) return TREE_NOT_OK;
+
+    PageHeader header;
+    strcpy(header.sign, INDEX_SIGN);
+    header.size  = prop.st_size;
+    header.mtime = prop.st_mtime;
+    header.depth = PAGE_DEPTH;
+    header.num   = pages.getSize();
+
+    fwrite(&header, sizeof(header), 1, idx);
+    if (header.num != 0) fwrite(&pages[0], sizeof(PageEntry), header.num, idx);
+
+    fclose(idx);
+
+    return TREE_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::readPage (Page<TYPE>* page, char*& text, size_t& size)
+{
+    assert(pagename_ != nullptr);
+
+    char* idxname = new char [strlen(pagename_) + strlen(INDEX_SUFFIX) + 1] {};
+    strcpy(idxname, pagename_);
+    strcat(idxname, INDEX_SUFFIX);
+
+    FILE* idx  = fopen(idxname, "rb");
+    FILE* base = fopen(pagename_, "rb");
+    delete [] idxname;
+
+    if ((idx == nullptr) || (base == nullptr))
+    {
+        if (idx  != nullptr) fclose(idx);
+        if (base != nullptr) fclose(base);
+        return TREE_WRONG_PAGE;
+    }
+
+    unsigned long long begin = 0;
+    unsigned long long end   = CountSize(base);
+    size_t             first = 0;
+    size_t             last  = pages_num_;
+
+    if (page != nullptr)
+    {
+        begin = page->entry.begin;
+        end   = page->entry.end;
+        first = page->id + 1;
+        last  = first + page->entry.count;
+    }
+
+    // subpages right below the page, the entries of deeper ones are skipped
+    SmallStack<PageEntry> subpages;
+    SmallStack<size_t>    ids;
+
+    int    err   = TREE_OK;
+    size_t total = end - begin + 2;
+
+    char line[MAX_PAGE_LINE] = "";
+
+    for (size_t id = first; (id < last) && (err == TREE_OK); )
+    {
+        PageEntry entry;
+
+        fseek(idx, sizeof(PageHeader) + id * sizeof(PageEntry), SEEK_SET);
+        if ((fread(&entry, sizeof(entry), 1, idx) != 1) || (entry.begin < begin) || (entry.end > end) || (entry.begin > entry.end))
         {
-            tree.path2badnode_.Push(data_);
-            return TREE_WRONG_PREV_NODE;
+            err = TREE_WRONG_PAGE;
+            break;
         }
 
-    if (right_ != nullptr)
-        if (right_->prev_ != this)
+        subpages.Push(entry);
+        ids.Push(id);
+
+        total -= entry.end - entry.begin;
+        total += snprintf(line, MAX_PAGE_LINE, "%c%lu %llu %llu %llu\n", PAGE_SIGN, id, entry.begin, entry.end, entry.count);
+
+        id += entry.count + 1;
+    }
+
+    text = (err == TREE_OK) ? (char*)calloc(total + 2, 1) : nullptr;
+    if ((err == TREE_OK) && (text == nullptr)) err = TREE_NO_MEMORY;
+
+    char*              cur = text;
+    unsigned long long pos = begin;
+
+    for (size_t i = 0; (i <= subpages.getSize()) && (err == TREE_OK); ++i)
+    {
+        unsigned long long next = (i < subpages.getSize()) ? subpages[i].begin : end;
+
+        fseek(base, pos, SEEK_SET);
+        if (fread(cur, 1, next - pos, base) != next - pos)
         {
-            tree.path2badnode_.Push(data_);
-            return TREE_WRONG_PREV_NODE;
+            err = TREE_WRONG_PAGE;
+            break;
         }
+        cur += next - pos;
 
-    if (left_ != nullptr)
-        if (left_->prev_ != this)
+        if (i < subpages.getSize())
         {
-            tree.path2badnode_.Push(data_);
-            return TREE_WRONG_PREV_NODE;
+            cur += sprintf(cur, "%c%lu %llu %llu %llu\n", PAGE_SIGN, ids[i], subpages[i].begin, subpages[i].end, subpages[i].count);
+            pos  = subpages[i].end;
         }
+    }
 
-    int err = TREE_OK;
-
-    if (right_ != nullptr)
-        err = right_->Check(tree);
+    fclose(idx);
+    fclose(base);
 
     if (err)
     {
-        tree.path2badnode_.Push(data_);
+        free(text);
+        text = nullptr;
         return err;
     }
 
-    if (left_ != nullptr)
-        err = left_->Check(tree);
+    // the page is parsed as a node, so it is closed like the node in the base
+    if (page != nullptr)
+    {
+        *cur++ = CLOSE_BRACKET;
+        *cur++ = '\n';
+    }
+
+    size = cur - text;
+
+    return TREE_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+bool Tree<TYPE>::isUnder (Node<TYPE>* node, Node<TYPE>* sub)
+{
+    TREE_ASSERTOK(((node == nullptr) || (sub == nullptr)), TREE_NULL_INPUT_NODE_PTR, -1, false);
+
+    if (not numbered_) Number();
+
+    return (sub->pre_ <= node->pre_) && (node->pre_ < sub->end_);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Tree<TYPE>::leafRange (Node<TYPE>* sub, size_t& begin, size_t& end)
+{
+    TREE_ASSERTOK((sub == nullptr), TREE_NULL_INPUT_NODE_PTR, -1);
+
+    if (not numbered_) Number();
+
+    begin = sub->leaf_begin_;
+    end   = sub->leaf_end_;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+Node<TYPE>* Tree<TYPE>::getNode (size_t id)
+{
+    if (not numbered_) Number();
+
+    TREE_ASSERTOK((id >= nodes_num_), TREE_MEM_ACCESS_VIOLATION, -1, nullptr);
+
+    return order_[id];
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+Node<TYPE>* Tree<TYPE>::getLeaf (size_t id)
+{
+    if (not numbered_) Number();
+
+    TREE_ASSERTOK((id >= leaves_num_), TREE_MEM_ACCESS_VIOLATION, -1, nullptr);
+
+    return leaves_[id];
+}
+
+//------------------------------------------------------------------------------
+
+template<typename TYPE>
+bool isPOISON (Tree<TYPE> tree)
+{
+    return ( (tree.name_        == nullptr) &&
+             (tree.root_        == nullptr) &&
+             (tree.getId()      == 0)       &&
+             (tree.getErrCode() == 0) );
+}
+
+//------------------------------------------------------------------------------
+
+template<typename TYPE>
+void TypePrint (FILE* fp, const Tree<TYPE>& tree)
+{
+    fprintf(fp, "%s", tree.name_);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::Check (int (*check)(Node<TYPE>* node), int* check_err)
+{
+    MET_TIMER(MET_CHECK);
 
-    if (err) tree.path2badnode_.Push(data_);
+    if (path2badnode_.getSize() != 0) path2badnode_.Clean();
+
+    int data_err = 0;
+    int err      = TREE_OK;
+
+    Node<TYPE>* bad = nullptr;
+
+    // top levels are checked here until they are wide enough to be split
+    Node<TYPE>* levels[2][2 * CHECK_TASKS] = {};
+    Node<TYPE>** level = levels[0];
+    size_t       num   = 0;
+
+    if (root_ != nullptr) level[num++] = root_;
+
+    while ((num != 0) && (num < CHECK_TASKS) && (err == TREE_OK))
+    {
+        Node<TYPE>** next = (level == levels[0]) ? levels[1] : levels[0];
+        size_t next_num = 0;
+
+        for (size_t i = 0; i < num; ++i)
+        {
+            err = checkNode(level[i], check, data_err);
+            if (err)
+            {
+                bad = level[i];
+                break;
+            }
+
+            if (level[i]->right_ != nullptr) next[next_num++] = level[i]->right_;
+            if (level[i]->left_  != nullptr) next[next_num++] = level[i]->left_;
+        }
+
+        level = next;
+        num   = next_num;
+    }
+
+    if ((err == TREE_OK) && (num != 0))
+    {
+        int         errs     [2 * CHECK_TASKS] = {};
+        int         data_errs[2 * CHECK_TASKS] = {};
+        Node<TYPE>* bads     [2 * CHECK_TASKS] = {};
+
+        // subtrees after the first bad one are not needed
+        std::atomic<size_t> first_bad(num);
+
+        GetThreadPool().ParallelFor(num, [&] (size_t i)
+        {
+            if (i > first_bad.load(std::memory_order_relaxed)) return;
+
+            errs[i] = checkSubtree(level[i], check, data_errs[i], bads[i]);
+            if (errs[i] == TREE_OK) return;
+
+            size_t first = first_bad.load(std::memory_order_relaxed);
+            while ((i < first) && (not first_bad.compare_exchange_weak(first, i, std::memory_order_relaxed)));
+        });
+
+        size_t first = first_bad.load();
+        if (first < num)
+        {
+            err      = errs     [first];
+            data_err = data_errs[first];
+            bad      = bads     [first];
+        }
+    }
+
+    if (err)
+    {
+        // every node below the root was reached by a link verified in its parent
+        for (Node<TYPE>* up = bad; up != nullptr; up = (up == root_) ? nullptr : up->prev_)
+            path2badnode_.Push(up->data_);
+    }
+
+    if (check_err != nullptr) *check_err = data_err;
+
+    // data rejected by the caller is not a problem of the tree itself
+    errCode_ = (err == TREE_WRONG_NODE_DATA) ? TREE_OK : err;
+
+    return err;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::checkSubtree (Node<TYPE>* sub, int (*check)(Node<TYPE>* node), int& check_err, Node<TYPE>*& bad)
+{
+    assert(sub != nullptr);
+
+    Node<TYPE>* node_cur = sub;
+
+    while (node_cur != nullptr)
+    {
+        int err = checkNode(node_cur, check, check_err);
+        if (err)
+        {
+            bad = node_cur;
+            return err;
+        }
+
+        if ((node_cur->right_ != nullptr) || (node_cur->left_ != nullptr))
+        {
+            node_cur = (node_cur->right_ != nullptr) ? node_cur->right_ : node_cur->left_;
+            continue;
+        }
+
+        // leaf, go up to the first node whose left subtree is not visited
+        Node<TYPE>* child = node_cur;
+        node_cur = nullptr;
+
+        while (child != sub)
+        {
+            Node<TYPE>* parent = child->prev_;
+
+            if ((child == parent->right_) && (parent->left_ != nullptr))
+            {
+                node_cur = parent->left_;
+                break;
+            }
+
+            child = parent;
+        }
+    }
+
+    return TREE_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Tree<TYPE>::writeNodes (Node<TYPE>* sub, Node<TYPE>* top, Writer& out, SmallStack<PageEntry>* pages)
+{
+    assert(sub != nullptr);
+
+    // wide levels are split into subtrees, mount points are written with their shards
+    Node<TYPE>* levels[2][2 * WRITE_TASKS] = {};
+    Node<TYPE>** level = levels[0];
+    size_t       num   = 0;
+
+    if (GetThreadPool().getThreadsNum() > 1) level[num++] = sub;
+
+    while ((num != 0) && (num < WRITE_TASKS))
+    {
+        Node<TYPE>** next = (level == levels[0]) ? levels[1] : levels[0];
+        size_t next_num = 0;
+
+        for (size_t i = 0; i < num; ++i)
+        {
+            if ((level[i]->shard_ != nullptr) && (level[i] != top)) continue;
+
+            if (level[i]->right_ != nullptr) next[next_num++] = level[i]->right_;
+            if (level[i]->left_  != nullptr) next[next_num++] = level[i]->left_;
+        }
+
+        level = next;
+        num   = next_num;
+    }
+
+    WritePart<TYPE>* parts = nullptr;
+    if (num != 0) parts = new (std::nothrow) WritePart<TYPE> [num];
+    if (parts == nullptr) num = 0;
+
+    for (size_t i = 0; i < num; ++i)
+    {
+        parts[i].node = level[i];
+        parts[i].text.setCompact(out.isCompact());
+    }
+
+    GetThreadPool().ParallelFor(num, [&] (size_t i)
+    {
+        parts[i].err = parts[i].node->Write(parts[i].text, top, (pages != nullptr) ? &parts[i].pages : nullptr);
+    });
+
+    int err = sub->Write(out, top, pages, parts, num);
+    if (err == TREE_OK) err = out.getErrCode();
+
+    delete [] parts;
 
     return err;
 }
 
 //------------------------------------------------------------------------------
 
+template <typename TYPE>
+int Tree<TYPE>::checkNode (Node<TYPE>* node, int (*check)(Node<TYPE>* node), int& check_err)
+{
+    assert(node != nullptr);
+
+    int err = node->Check();
+    if (err) return err;
+
+    if (check != nullptr)
+    {
+        check_err = check(node);
+        if (check_err) return TREE_WRONG_NODE_DATA;
+    }
+
+    return TREE_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+int Node<TYPE>::Check () const
+{
+    if (((prev_ == nullptr) && (depth_ != 0)) ||
+        ((prev_ != nullptr) && (depth_ != prev_->depth_ + 1)))
+        return TREE_WRONG_DEPTH;
+
+    if (prev_ != nullptr)
+        if ((prev_->right_ != this) &&
+            (prev_->left_  != this))
+            return TREE_WRONG_PREV_NODE;
+
+    if ((right_ != nullptr) && ((right_->prev_ != this) || (right_ == left_)))
+        return TREE_WRONG_PREV_NODE;
+
+    if ((left_ != nullptr) && (left_->prev_ != this))
+        return TREE_WRONG_PREV_NODE;
+
+    return TREE_OK;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+const Stack<TYPE>& Tree<TYPE>::getBadPath () const
+{
+    return path2badnode_;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Tree<TYPE>::setCompact (bool compact)
+{
+    compact_ = compact;
+}
+
+//------------------------------------------------------------------------------
+
 template <typename TYPE>
 int Tree<TYPE>::getErrCode ()
 {
@@ -644,41 +2661,17 @@ void Tree<TYPE>::PrintError (const char* logname, const char* file, int line, co
     assert(logname  != nullptr);
     assert(file     != nullptr);
 
-    FILE* log = fopen(logname, "a");
-    assert(log != nullptr);
-
-    fprintf(log, "********************************************************************************\n");
-
-    time_t t = time(NULL);
-    struct tm tm = *localtime(&t);
-    fprintf(log, "TIME: %d-%02d-%02d %02d:%02d:%02d\n\n",
-            tm.tm_year + 1900,
-            tm.tm_mon + 1,
-            tm.tm_mday,
-            tm.tm_hour,
-            tm.tm_min,
-            tm.tm_sec);
-
-    fprintf(log, "ERROR: file %s  line %d  function %s\n\n", file, line, function);
-    fprintf(log, "%s\n", tree_errstr[err + 1]);
-    if (errline != -1) fprintf(log, "line %d\n", errline + 1);
-
-    if (path2badnode_.getSize() != 0)
+    char   path[LOG_RECORD_SIZE] = "";
+    size_t len = 0;
+    for (int i = path2badnode_.getSize() - 1; (i > -1) && (len + 8 < LOG_RECORD_SIZE); --i)
     {
-        fprintf(log, "%s", path2badnode_.getName());
-        for (int i = path2badnode_.getSize() - 1; i > -1; --i)
-        {
-            fprintf(log, " -> [");
-            TypePrint(log, path2badnode_[i]);
-            fprintf(log, "]");
-        }
-
-        fprintf(log, "\n");
+        len += snprintf(path + len, LOG_RECORD_SIZE - len, "%s[", (len == 0) ? "" : " -> ");
+        if (len < LOG_RECORD_SIZE) len += TypeSprint(path + len, LOG_RECORD_SIZE - len, path2badnode_[i]);
+        if (len < LOG_RECORD_SIZE) len += snprintf(path + len, LOG_RECORD_SIZE - len, "]");
     }
-    if (err != TREE_WRONG_SYNTAX_INPUT_BASE) fprintf(log, "You can look tree dump in %s\n\n", DUMP_PICT_NAME);
-    fclose(log);
 
-    ////
+    LogWrite(LOG_ERROR, logname, "lib=tree file=%s line=%d func=\"%s\" code=%d error=\"%s\" base_line=%d path=\"%s\"",
+             file, line, function, err, tree_errstr[err + 1], (errline != -1) ? errline + 1 : 0, path);
 
     printf("ERROR: file %s  line %d  function %s\n", file, line, function);
     printf("%s\n\n", tree_errstr[err + 1]);
@@ -696,7 +2689,6 @@ void Tree<TYPE>::PrintError (const char* logname, const char* file, int line, co
 
         printf("\n");
     }
-    if (err != TREE_WRONG_SYNTAX_INPUT_BASE) printf (     "You can look tree dump in %s\n\n", DUMP_PICT_NAME);
 }
 
 //------------------------------------------------------------------------------
@@ -706,13 +2698,7 @@ void Tree<TYPE>::PrintBase (Text& base, size_t line, const char* logname)
 {
     assert(logname != nullptr);
 
-    FILE* log = fopen(logname, "a");
-    assert(log != nullptr);
-
-    fprintf(log, "\n");
     printf (     "\n");
-
-    fprintf(log, "////////////////--TEXT-SECTION--////////////////" "\n");
     printf (     "////////////////--TEXT-SECTION--////////////////" "\n");
 
     size_t true_line = line + 1;
@@ -721,15 +2707,13 @@ void Tree<TYPE>::PrintBase (Text& base, size_t line, const char* logname)
     {
         if ((true_line + i > 0) && (true_line + i <= base.num_))
         {
-            fprintf(log, "%s%5ld: %s\n", ((i == 0)? "=>" : "  "), true_line + i, base.lines_[true_line + i - 1].str);
+            LogWrite(LOG_ERROR, logname, "lib=tree base_line=%lu wrong=%d text=\"%s\"",
+                     true_line + i, (i == 0), base.lines_[true_line + i - 1].str);
             printf (     "%s%5ld: %s\n", ((i == 0)? "=>" : "  "), true_line + i, base.lines_[true_line + i - 1].str);
         }
     }
 
-    fprintf(log, "////////////////////////////////////////////////" "\n\n");
     printf (     "////////////////////////////////////////////////" "\n\n");
-
-    fclose(log);
 }
 
 //------------------------------------------------------------------------------
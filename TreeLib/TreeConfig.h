@@ -37,9 +37,38 @@ char const * const DUMP_NAME         = "graph.dot";
 char const * const DUMP_PICT_NAME    = "graph.png";
 char const * const DEFAULT_BASE_NAME = "Base.dat";
 char const * const TREE_LOGNAME      = "tree.log";
+char const * const STATS_SUFFIX      = ".stat";
+char const * const INDEX_SUFFIX      = ".idx";
+char const * const INDEX_SIGN        = "AKNIDX1";
 
 const char OPEN_BRACKET  = '[';
 const char CLOSE_BRACKET = ']';
+const char MOUNT_SIGN    = '@';
+const char PAGE_SIGN     = '&';
+
+const size_t HOT_LAYOUT_DEPTH = 4;
+const size_t COLD_VISITS      = 1;
+const bool   SHARE_LABELS     = true;
+const size_t PAGE_DEPTH       = 8;
+const size_t PAGE_LIMIT       = 64;
+const size_t MAX_PAGE_LINE    = 96;
+const size_t MAX_LABEL_LINE   = 256; // longer base lines are skipped when pages are searched
+
+const size_t CHECK_TASKS      = 64;
+const size_t WRITE_TASKS      = 64;
+
+const size_t WRITER_BUFFER_SIZE = 1 << 16;
+const size_t MAX_PRINT_LEN      = 64;
+const size_t INDENT_SIZE        = 4;
+const size_t MAX_INDENT_LEN     = 1024; // lines below depth 256 take a few copies
+const bool   COMPACT_BASE       = false;
+
+
+enum GraphFormats
+{
+    GRAPH_DOT                                                       ,
+    GRAPH_JSON                                                      ,
+};
 
 
 enum TreeErrors
@@ -54,12 +83,18 @@ enum TreeErrors
     TREE_INPUT_DATA_POISON                                          ,
     TREE_MEM_ACCESS_VIOLATION                                       ,
     TREE_NOT_CONSTRUCTED                                            ,
+    TREE_NULL_INPUT_NODE_PTR                                        ,
     TREE_NULL_INPUT_TREE_PTR                                        ,
     TREE_NULL_TREE_PTR                                              ,
+    TREE_SHARD_NOT_FOUND                                            ,
     TREE_WRONG_DEPTH                                                ,
     TREE_WRONG_INPUT_TREE_NAME                                      ,
+    TREE_WRONG_NODE_DATA                                            ,
+    TREE_WRONG_PACK                                                 ,
+    TREE_WRONG_PAGE                                                 ,
     TREE_WRONG_PREV_NODE                                            ,
     TREE_WRONG_SYNTAX_INPUT_BASE                                    ,
+    TREE_WRONG_WRITE                                                ,
 };
 
 char const * const tree_errstr[] =
@@ -74,12 +109,18 @@ char const * const tree_errstr[] =
     "Input data is poison"                                          ,
     "Memory access violation"                                       ,
     "Tree did not constructed, operation is impossible"             ,
+    "The input value of the node pointer turned out to be zero"     ,
     "The input value of the tree pointer turned out to be zero"     ,
     "The pointer to the tree is null, tree lost"                    ,
+    "Shard file of the mount point is not found"                    ,
     "Wrong node depth found"                                        ,
     "Wrong input tree name"                                         ,
+    "Data of the node is rejected by the check"                     ,
+    "Failed to read or write packed base"                           ,
+    "Failed to read page of the base"                               ,
     "Wrong pointer to previous node found"                          ,
     "Wrong syntax of input base"                                    ,
+    "Failed to write the base"                                      ,
 };
 
 
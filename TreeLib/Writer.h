@@ -0,0 +1,218 @@
+/*------------------------------------------------------------------------------
+    * File:        Writer.h                                                    *
+    * Description: Declaration of the buffered output of the base text.        *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+#ifndef WRITER_H_INCLUDED
+#define WRITER_H_INCLUDED
+
+#define _CRT_SECURE_NO_WARNINGS
+
+
+#include "../MetricLib/Metric.h"
+#include "TreeConfig.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <new>
+
+
+/*------------------------------------------------------------------------------
+    Writer collects the text in its buffer. With a file it writes the buffer
+    when it is full, so the file gets a few large writes, without a file the
+    buffer grows and keeps the whole text. Indentation is copied from one
+    string of spaces, compact writer omits it.
+*///----------------------------------------------------------------------------
+
+class Writer
+{
+    int state_ = TREE_OK;
+
+    bool   compact_ = false;
+    FILE*  file_    = nullptr;
+    char*  buf_     = nullptr;
+    size_t len_     = 0;
+    size_t cap_     = 0;
+    size_t flushed_ = 0;
+
+public:
+
+//------------------------------------------------------------------------------
+/*! @brief   Writer constructor.
+ *
+ *  @param   file        Output file, nullptr to keep the text in memory
+ *  @param   compact     true to write lines without indentation
+ */
+
+    explicit Writer (FILE* file = nullptr, bool compact = false);
+
+//------------------------------------------------------------------------------
+/*! @brief   Writer copy constructor (deleted).
+ *
+ *  @param   obj         Source writer
+ */
+
+    Writer (const Writer& obj);
+
+    Writer& operator = (const Writer& obj); // deleted
+
+//------------------------------------------------------------------------------
+/*! @brief   Writer destructor, the rest of the buffer is not written.
+ */
+
+   ~Writer ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Add the bytes to the text.
+ *
+ *  @param   data        Pointer to the bytes
+ *  @param   len         Number of bytes
+ */
+
+    void Write (const char* data, size_t len);
+
+//------------------------------------------------------------------------------
+/*! @brief   Add the character to the text.
+ *
+ *  @param   c           Character
+ */
+
+    void Write (char c);
+
+//------------------------------------------------------------------------------
+/*! @brief   Add the string literal to the text, its length is known at compile time.
+ *
+ *  @param   str         String literal
+ */
+
+    template <size_t LEN>
+    void Write (const char (&str)[LEN]);
+
+//------------------------------------------------------------------------------
+/*! @brief   Add the indentation of the level to the text.
+ *
+ *  @param   level       Level of the line, it is indented by INDENT_SIZE spaces for each
+ */
+
+    void Indent (size_t level);
+
+//------------------------------------------------------------------------------
+/*! @brief   Add the printed value to the text.
+ *
+ *  @param   value       Value
+ */
+
+    template <typename TYPE>
+    void Print (const TYPE& value);
+
+//------------------------------------------------------------------------------
+/*! @brief   Add the printed value in double quotes, quotes and backslashes
+ *           in it are escaped and control characters are replaced by spaces,
+ *           so it is a string both for graphviz and JSON.
+ *
+ *  @param   value       Value
+ */
+
+    template <typename TYPE>
+    void Quote (const TYPE& value);
+
+//------------------------------------------------------------------------------
+/*! @brief   Add the decimal number to the text.
+ *
+ *  @param   num         Number
+ */
+
+    void Number (size_t num);
+
+//------------------------------------------------------------------------------
+/*! @brief   Write the buffer to the file.
+ *
+ *  @return  error code
+ */
+
+    int Flush ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Get position in the text where the next byte is added.
+ *
+ *  @return  size of the text
+ */
+
+    size_t getPos () const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Get the text kept in memory, it is null terminated.
+ *
+ *  @return  pointer to the text, nullptr if there is no text
+ */
+
+    const char* getText () const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Set writing of lines without indentation.
+ *
+ *  @param   compact     true to write lines without indentation
+ */
+
+    void setCompact (bool compact);
+
+//------------------------------------------------------------------------------
+/*! @brief   Check that lines are written without indentation.
+ *
+ *  @return  true if lines are not indented, else false
+ */
+
+    bool isCompact () const;
+
+//------------------------------------------------------------------------------
+/*! @brief   Get error code of the writer, the first error stops the output.
+ *
+ *  @return  error code
+ */
+
+    int getErrCode () const;
+
+//------------------------------------------------------------------------------
+
+private:
+
+//------------------------------------------------------------------------------
+/*! @brief   Make room for the bytes in the buffer.
+ *
+ *  @param   len         Number of bytes
+ *
+ *  @return  true if the bytes fit in the buffer, else false
+ */
+
+    bool Reserve (size_t len);
+
+//------------------------------------------------------------------------------
+/*! @brief   Get the string of spaces for indentation, it is filled at the first call.
+ *
+ *  @return  string of MAX_INDENT_LEN spaces
+ */
+
+    static const char* Spaces ();
+
+//------------------------------------------------------------------------------
+/*! @brief   Add the string in double quotes with escaped characters.
+ *
+ *  @param   str         String
+ */
+
+    void QuoteString (const char* str);
+
+//------------------------------------------------------------------------------
+};
+
+//------------------------------------------------------------------------------
+
+#include "Writer.ipp"
+
+#endif // WRITER_H_INCLUDED
@@ -0,0 +1,277 @@
+/*------------------------------------------------------------------------------
+    * File:        Writer.ipp                                                  *
+    * Description: Functions for the buffered output of the base text.         *
+    * Created:     19 oct 2026                                                 *
+    * Author:      Artem Puzankov                                              *
+    * Email:       puzankov.ao@phystech.edu                                    *
+    * GitHub:      https://github.com/hellopuza                                *
+    * Copyright © 2021 Artem Puzankov. All rights reserved.                    *
+    *///------------------------------------------------------------------------
+
+inline Writer::Writer (FILE* file, bool compact) :
+    compact_ (compact),
+    file_    (file)
+{}
+
+//------------------------------------------------------------------------------
+
+inline Writer::~Writer ()
+{
+    if (buf_ != nullptr) MET_FREE(MEM_TEXTS, cap_);
+
+    delete [] buf_;
+    buf_ = nullptr;
+    len_ = 0;
+    cap_ = 0;
+}
+
+//------------------------------------------------------------------------------
+
+inline void Writer::Write (const char* data, size_t len)
+{
+    assert(data != nullptr);
+
+    if (state_ != TREE_OK) return;
+
+    if (Reserve(len))
+    {
+        memcpy(buf_ + len_, data, len);
+        len_ += len;
+        buf_[len_] = '\0';
+    }
+    else if (file_ != nullptr)
+    {
+        // the bytes do not fit in the empty buffer, they are written at once
+        if (fwrite(data, 1, len, file_) != len) state_ = TREE_WRONG_WRITE;
+        flushed_ += len;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+inline void Writer::Write (char c)
+{
+    if ((state_ != TREE_OK) || (not Reserve(1))) return;
+
+    buf_[len_++] = c;
+    buf_[len_]   = '\0';
+}
+
+//------------------------------------------------------------------------------
+
+template <size_t LEN>
+void Writer::Write (const char (&str)[LEN])
+{
+    Write(str, LEN - 1);
+}
+
+//------------------------------------------------------------------------------
+
+inline void Writer::Indent (size_t level)
+{
+    if (compact_) return;
+
+    const char* spaces = Spaces();
+
+    for (size_t len = level * INDENT_SIZE; len != 0; )
+    {
+        size_t part = (len < MAX_INDENT_LEN) ? len : MAX_INDENT_LEN;
+        Write(spaces, part);
+        len -= part;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Writer::Print (const TYPE& value)
+{
+    char str[MAX_PRINT_LEN] = "";
+
+    int len = TypeSprint(str, MAX_PRINT_LEN, value);
+    if (len < 0) return;
+
+    Write(str, ((size_t)len < MAX_PRINT_LEN) ? len : MAX_PRINT_LEN - 1);
+}
+
+template <>
+inline void Writer::Print<char*> (char* const& value)
+{
+    if (value == nullptr) Write("(null)", 6);
+    else                  Write(value, strlen(value));
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TYPE>
+void Writer::Quote (const TYPE& value)
+{
+    char str[MAX_PRINT_LEN] = "";
+
+    if (TypeSprint(str, MAX_PRINT_LEN, value) < 0) str[0] = '\0';
+
+    QuoteString(str);
+}
+
+template <>
+inline void Writer::Quote<char*> (char* const& value)
+{
+    QuoteString((value == nullptr) ? "(null)" : value);
+}
+
+//------------------------------------------------------------------------------
+
+inline void Writer::Number (size_t num)
+{
+    char   str[24] = "";
+    size_t len     = sizeof(str);
+
+    do str[--len] = '0' + num % 10;
+    while ((num /= 10) != 0);
+
+    Write(str + len, sizeof(str) - len);
+}
+
+//------------------------------------------------------------------------------
+
+inline int Writer::Flush ()
+{
+    if ((state_ != TREE_OK) || (file_ == nullptr) || (len_ == 0)) return state_;
+
+    if (fwrite(buf_, 1, len_, file_) != len_) state_ = TREE_WRONG_WRITE;
+
+    flushed_ += len_;
+    len_ = 0;
+
+    return state_;
+}
+
+//------------------------------------------------------------------------------
+
+inline size_t Writer::getPos () const
+{
+    return flushed_ + len_;
+}
+
+//------------------------------------------------------------------------------
+
+inline const char* Writer::getText () const
+{
+    return buf_;
+}
+
+//------------------------------------------------------------------------------
+
+inline void Writer::setCompact (bool compact)
+{
+    compact_ = compact;
+}
+
+//------------------------------------------------------------------------------
+
+inline bool Writer::isCompact () const
+{
+    return compact_;
+}
+
+//------------------------------------------------------------------------------
+
+inline int Writer::getErrCode () const
+{
+    return state_;
+}
+
+//------------------------------------------------------------------------------
+
+inline bool Writer::Reserve (size_t len)
+{
+    if (len_ + len < cap_) return true;
+
+    if (file_ != nullptr)
+    {
+        Flush();
+
+        if (cap_ == 0)
+        {
+            buf_ = new (std::nothrow) char [WRITER_BUFFER_SIZE];
+            if (buf_ == nullptr)
+            {
+                state_ = TREE_NO_MEMORY;
+                return false;
+            }
+
+            cap_ = WRITER_BUFFER_SIZE;
+            MET_ALLOC(MEM_TEXTS, cap_);
+        }
+
+        return (state_ == TREE_OK) && (len_ + len < cap_);
+    }
+
+    size_t capacity = (cap_ == 0) ? WRITER_BUFFER_SIZE : cap_ * 2;
+    while (capacity <= len_ + len) capacity *= 2;
+
+    char* temp = new (std::nothrow) char [capacity];
+    if (temp == nullptr)
+    {
+        state_ = TREE_NO_MEMORY;
+        return false;
+    }
+
+    if (buf_ != nullptr)
+    {
+        memcpy(temp, buf_, len_ + 1);
+        MET_FREE(MEM_TEXTS, cap_);
+    }
+
+    delete [] buf_;
+    buf_ = temp;
+    cap_ = capacity;
+    MET_ALLOC(MEM_TEXTS, cap_);
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+inline void Writer::QuoteString (const char* str)
+{
+    assert(str != nullptr);
+
+    Write('"');
+
+    // plain runs are copied at once
+    const char* run = str;
+    for (; *str != '\0'; ++str)
+    {
+        unsigned char c = *str;
+        if ((c != '"') && (c != '\\') && (c >= ' ')) continue;
+
+        Write(run, str - run);
+
+        if (c < ' ') Write(' ');
+        else
+        {
+            Write('\\');
+            Write((char)c);
+        }
+
+        run = str + 1;
+    }
+
+    Write(run, str - run);
+    Write('"');
+}
+
+//------------------------------------------------------------------------------
+
+inline const char* Writer::Spaces ()
+{
+    static char spaces[MAX_INDENT_LEN] = "";
+    static bool filled = (memset(spaces, ' ', MAX_INDENT_LEN) != nullptr);
+
+    (void)filled;
+
+    return spaces;
+}
+
+//------------------------------------------------------------------------------
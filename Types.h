@@ -101,5 +101,34 @@ void TypePrint (FILE* fp, const TYPE& value)
     fprintf(fp, PRINT_FORMAT<TYPE>, value);
 }
 
+// POISON of strings is the null pointer, it can not be printed by "%s"
+template <>
+inline void TypePrint<char*> (FILE* fp, char* const& value)
+{
+    fprintf(fp, "%s", (value == nullptr) ? "(null)" : value);
+}
+
+//------------------------------------------------------------------------------
+/*! @brief   Print values of any type to the string.
+ *
+ *  @param   str         Output string
+ *  @param   size        Size of the output string
+ *  @param   value       Value to print
+ *
+ *  @return  number of characters that would be printed without the size limit
+ */
+
+template <typename TYPE>
+int TypeSprint (char* str, size_t size, const TYPE& value)
+{
+    return snprintf(str, size, PRINT_FORMAT<TYPE>, value);
+}
+
+template <>
+inline int TypeSprint<char*> (char* str, size_t size, char* const& value)
+{
+    return snprintf(str, size, "%s", (value == nullptr) ? "(null)" : value);
+}
+
 
 #endif // TYPES_H
@@ -26,13 +26,11 @@ int main(int argc, char* argv[])
     if (argc == 1)
     {
         Akinator akn;
-        akn.Run();
+        return akn.Run();
     }
     else
     {
         Akinator akn(argv[1]);
-        akn.Run();
+        return akn.Run();
     }
-
-    return 0;
 }
\ No newline at end of file